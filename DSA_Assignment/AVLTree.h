@@ -1,60 +1,281 @@
 #pragma once
 #include <iostream>
 #include <vector>
+#include <utility>
+#include <type_traits>
+#include <iterator>
+#include <cstddef>
+
+#include "NodePool.h"
 using namespace std;
 
-// Node structure for AVL Tree
-template <typename T>
-struct AVLNode {
+// Largest height an AVL tree can reach in memory (a tree of height 64 would need more than 2^44 nodes)
+const int AVL_TREE_MAX_HEIGHT = 64;
+
+/*
+    Aggregate used when a tree keeps no per-subtree summary (it takes no space in the nodes)
+
+    An Aggregate is a summary of the elements of a subtree, kept in every node. It needs a default
+    constructor giving the summary of no elements, reset(element) to summarize one element, and
+    merge(other) to add another summary to it. merge must be associative and commutative (e.g. max,
+    sum, count), since subtrees are combined in whatever order the tree's shape gives.
+*/
+struct NoAggregate {
+    template <typename T>
+    void reset(const T&) {}
+    void merge(const NoAggregate&) {}
+};
+
+// Node structure for AVL Tree (the node is also the summary of its subtree)
+template <typename T, typename Aggregate = NoAggregate>
+struct AVLNode : Aggregate {
     T data;               // Data stored in the node
     AVLNode* left;        // Pointer to the left child
     AVLNode* right;       // Pointer to the right child
+    AVLNode* parent;      // Pointer to the parent, nullptr for the root
     int height;           // Height of the node
+    int size;             // Number of nodes in the subtree rooted at this node
+
+    AVLNode(const T& data) : data(data), left(nullptr), right(nullptr), parent(nullptr), height(1), size(1) {
+        Aggregate::reset(this->data);
+    }
+    AVLNode(T&& data) : data(std::move(data)), left(nullptr), right(nullptr), parent(nullptr), height(1), size(1) {
+        Aggregate::reset(this->data);
+    }
 
-    AVLNode(T data) : data(data), left(nullptr), right(nullptr), height(1) {}
+    // Constructs the element in place from the arguments of T's constructor (used by emplace)
+    template <typename... Args>
+    explicit AVLNode(in_place_t, Args&&... args)
+        : data(std::forward<Args>(args)...), left(nullptr), right(nullptr), parent(nullptr), height(1), size(1) {
+        Aggregate::reset(this->data);
+    }
 };
 
-// AVL Tree class
-template <typename T>
+/*
+    AVL Tree class
+
+    Insert, remove and find walk the tree iteratively. Insert and remove remember the links they followed
+    on a small stack and rebalance back up that path, so elements are never copied on the way down and
+    deep trees do not use deep recursion. Lookups only use operator<, and find, remove, lowerBound and
+    visitFrom accept any key type that can be compared with T in both directions (e.g. the key of a
+    KeyValuePair), so no temporary element has to be built to search for one.
+
+    Every node also points to its parent, so the tree can be walked in place with bidirectional iterators:
+    begin()/end() cover every element, and range(low, high) covers the elements between two keys in
+    O(log n + k) without copying the tree into a vector first.
+
+    Every node also counts the nodes in its subtree, which makes it an order-statistic tree:
+    select(k) finds the k-th smallest element and rank(key) counts the elements below a key in O(log n),
+    so the k largest elements are select(size() - k) and the iterators after it.
+
+    A tree can also keep an Aggregate of every subtree (see NoAggregate), e.g. the highest rating and the
+    number of ratings below each node. aggregate(low, high) then summarizes every element between two keys
+    in O(log n) by combining whole subtrees instead of visiting each element.
+
+    Nodes come from an Allocator (by default a NodePool), which must provide create(args...), destroy(node)
+    and releaseAll(). A tree uses its own pool unless it is given a pool to share with other trees; a tree
+    with its own pool is torn down by releasing the pool's chunks rather than freeing node by node.
+*/
+template <typename T, typename Aggregate = NoAggregate, typename Allocator = NodePool<AVLNode<T, Aggregate>>>
 class AVLTree {
 private:
-    AVLNode<T>* root;     
+    AVLNode<T, Aggregate>* root;     
+    Allocator ownPool;    // Pool used when no shared pool is given
+    Allocator* pool;      // Pool every node of this tree comes from
 
-    // Inserts a new node with data
-    AVLNode<T>* insert(AVLNode<T>* node, T data);         
+    // Links a new node into the tree, deleting it instead if an equal element exists
+    bool insertNode(AVLNode<T, Aggregate>* node);
 
-    // Removes a node with specific data
-    AVLNode<T>* remove(AVLNode<T>* node, const T& data);  
+    // Updates heights and rotates along a path of links, from the deepest one up
+    void rebalancePath(AVLNode<T, Aggregate>** path[], int depth);
 
-    // Finds a node with specific data
-    AVLNode<T>* find(AVLNode<T>* node, const T& data) const; 
-
-    // Finds the node with the minimum value in a subtree
-    AVLNode<T>* minValueNode(AVLNode<T>* node) const;     
+    // Updates the height of a node and rotates it if it is unbalanced, returns the new subtree root
+    AVLNode<T, Aggregate>* rebalance(AVLNode<T, Aggregate>* node);
 
     // Rotate Right and Left
-    AVLNode<T>* rotateRight(AVLNode<T>* node);            
-    AVLNode<T>* rotateLeft(AVLNode<T>* node);            
+    AVLNode<T, Aggregate>* rotateRight(AVLNode<T, Aggregate>* node);            
+    AVLNode<T, Aggregate>* rotateLeft(AVLNode<T, Aggregate>* node);            
 
     // Return Height of Tree
-    int getHeight(AVLNode<T>* node) const;               
+    int getHeight(AVLNode<T, Aggregate>* node) const;               
+
+    // Return the number of nodes in a subtree
+    int getSize(AVLNode<T, Aggregate>* node) const { return node ? node->size : 0; }
+
+    // Recomputes the height, subtree size and aggregate of a node from its children
+    void updateNode(AVLNode<T, Aggregate>* node);
 
     // Calculates the balance factor of a node
-    int getBalanceFactor(AVLNode<T>* node) const;      
+    int getBalanceFactor(AVLNode<T, Aggregate>* node) const;      
 
     // Function for in-order traversal
-    void inOrderTraversal(AVLNode<T>* node, vector<T>& items) const; 
+    void inOrderTraversal(AVLNode<T, Aggregate>* node, vector<T>& items) const; 
+
+    // Delete all nodes in a subtree, one at a time
+    void destroy(AVLNode<T, Aggregate>* node);                       
+
+    // Runs the destructors of a subtree's nodes without freeing them (the pool is released afterwards)
+    void destroyInPlace(AVLNode<T, Aggregate>* node);
 
     // Delete all nodes in the tree
-    void destroy(AVLNode<T>* node);                       
+    void clear();
+
+    // Builds a balanced subtree from items[low..high]
+    AVLNode<T, Aggregate>* build(const vector<T>& items, int low, int high);
 
 public:
-    AVLTree() : root(nullptr) {}  // Constructor
-    ~AVLTree();                   // Destructor
+    /*
+        Bidirectional iterator over the elements in ascending order
+
+        The elements cannot be changed through the iterator, since that could break the ordering.
+        An iterator stays valid until the element it points to is removed or the tree is rebuilt.
+    */
+    class const_iterator {
+    private:
+        const AVLNode<T, Aggregate>* node;     // Current node, nullptr at end()
+        const AVLTree* tree;        // Tree being walked, so that --end() can find the last element
+
+        friend class AVLTree;
+        const_iterator(const AVLNode<T, Aggregate>* node, const AVLTree* tree) : node(node), tree(tree) {}
+
+    public:
+        typedef bidirectional_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef ptrdiff_t difference_type;
+        typedef const T* pointer;
+        typedef const T& reference;
+
+        const_iterator() : node(nullptr), tree(nullptr) {}
+
+        const T& operator*() const { return node->data; }
+        const T* operator->() const { return &node->data; }
+
+        // Moves to the next element: the leftmost node of the right subtree, or the first ancestor reached from its left
+        const_iterator& operator++() {
+            if (node->right) {
+                node = node->right;
+                while (node->left)
+                    node = node->left;
+            }
+            else {
+                const AVLNode<T, Aggregate>* child = node;
+                node = node->parent;
+                while (node && child == node->right) {
+                    child = node;
+                    node = node->parent;
+                }
+            }
+            return *this;
+        }
+
+        // Moves to the previous element (from end() this is the largest element)
+        const_iterator& operator--() {
+            if (!node) {
+                node = tree->root;
+                while (node && node->right)
+                    node = node->right;
+            }
+            else if (node->left) {
+                node = node->left;
+                while (node->right)
+                    node = node->right;
+            }
+            else {
+                const AVLNode<T, Aggregate>* child = node;
+                node = node->parent;
+                while (node && child == node->left) {
+                    child = node;
+                    node = node->parent;
+                }
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int) { const_iterator old = *this; ++*this; return old; }
+        const_iterator operator--(int) { const_iterator old = *this; --*this; return old; }
+
+        bool operator==(const const_iterator& other) const { return node == other.node; }
+        bool operator!=(const const_iterator& other) const { return node != other.node; }
+    };
+    typedef const_iterator iterator;
+
+    // A pair of iterators that can be used in a range-based for loop
+    class Range {
+    private:
+        const_iterator first, last;
+
+    public:
+        Range(const_iterator first, const_iterator last) : first(first), last(last) {}
+        const_iterator begin() const { return first; }
+        const_iterator end() const { return last; }
+        bool empty() const { return first == last; }
+    };
+
+    AVLTree() : root(nullptr), pool(&ownPool) {}                                  // Constructor
+    explicit AVLTree(Allocator& sharedPool) : root(nullptr), pool(&sharedPool) {}  // Constructor using a shared pool
+    ~AVLTree();                                                                   // Destructor
+
+    // The tree owns its nodes, so it cannot be copied
+    AVLTree(const AVLTree&) = delete;
+    AVLTree& operator=(const AVLTree&) = delete;
+
+    // Insert an element, returns false if an equal element is already in the tree
+    bool insert(const T& data);
+    bool insert(T&& data);
+
+    // Constructs an element from args and moves it into a new node, returns false if it is a duplicate
+    template <typename... Args>
+    bool emplace(Args&&... args);
+
+    // Removes the element equal to key, returns false if there is none
+    template <typename Key>
+    bool remove(const Key& key);
+
+    // Returns the element equal to key, or nullptr
+    template <typename Key>
+    T* find(const Key& key) const;
+
+    // Replaces the contents with a balanced tree built from sorted, duplicate-free items in O(n)
+    void buildFromSorted(const vector<T>& items);
+
+    // Iterators over every element in ascending order
+    const_iterator begin() const;
+    const_iterator end() const { return const_iterator(nullptr, this); }
+
+    // Returns the first element not less than key, or end() if there is none
+    template <typename Key>
+    const_iterator lowerBound(const Key& key) const;
+
+    // Returns the first element greater than key, or end() if there is none
+    template <typename Key>
+    const_iterator upperBound(const Key& key) const;
+
+    // Returns the elements from low to high (both included) in ascending order
+    template <typename Key>
+    Range range(const Key& low, const Key& high) const;
+
+    // Calls visit(element) in ascending order starting at the first element not less than low,
+    // until visit returns false or the elements run out
+    template <typename Key, typename Visitor>
+    void visitFrom(const Key& low, Visitor visit) const;
+
+    // Returns the k-th smallest element (k starts at 0), or end() if k is out of range
+    const_iterator select(int k) const;
+
+    // Returns the number of elements less than key
+    template <typename Key>
+    int rank(const Key& key) const;
 
-    void insert(T data);          
-    void remove(const T& data);   
-    T* find(const T& data) const; 
+    // Returns the number of elements in the tree
+    int size() const { return getSize(root); }
+
+    // Returns the aggregate of the elements from low to high (both included)
+    template <typename Key>
+    Aggregate aggregate(const Key& low, const Key& high) const;
+
+    // Recomputes the aggregates that include the element equal to key, after a field the aggregate reads has changed
+    template <typename Key>
+    bool refresh(const Key& key);
 
     // Display all elements in sorted order
     void displayInOrder() const;  
@@ -72,8 +293,8 @@ public:
     Parameter - node: A pointer to the AVL tree node whose height is to be retrieved
     Return - The height of the node, or 0 if the node is null
 */
-template <typename T>
-int AVLTree<T>::getHeight(AVLNode<T>* node) const {
+template <typename T, typename Aggregate, typename Allocator>
+int AVLTree<T, Aggregate, Allocator>::getHeight(AVLNode<T, Aggregate>* node) const {
     return node ? node->height : 0;
 }
 
@@ -86,32 +307,52 @@ int AVLTree<T>::getHeight(AVLNode<T>* node) const {
     Parameter - node: A pointer to the AVL tree node whose balance factor is to be calculated
     Return - The balance factor (difference in heights of left and right subtrees), or 0 if the node is null
 */
-template <typename T>
-int AVLTree<T>::getBalanceFactor(AVLNode<T>* node) const {
+template <typename T, typename Aggregate, typename Allocator>
+int AVLTree<T, Aggregate, Allocator>::getBalanceFactor(AVLNode<T, Aggregate>* node) const {
     return node ? getHeight(node->left) - getHeight(node->right) : 0;
 }
 
+/*
+    Recomputes the height, subtree size and aggregate of a node
+
+    Parameter - node: A pointer to a node whose children are already up to date
+*/
+template <typename T, typename Aggregate, typename Allocator>
+void AVLTree<T, Aggregate, Allocator>::updateNode(AVLNode<T, Aggregate>* node) {
+    node->height = 1 + max(getHeight(node->left), getHeight(node->right));
+    node->size = 1 + getSize(node->left) + getSize(node->right);
+    node->reset(node->data);
+    if (node->left)
+        node->merge(*node->left);
+    if (node->right)
+        node->merge(*node->right);
+}
+
 /*
     Performs a right rotation on the given node in the AVL tree
 
     This functions rotates the node ( y ) to the right and making its left child ( x ) the new root of the sub tree
-	The right sub tree of x is reassigned to y and heights are updated
+	The right sub tree of x is reassigned to y and heights and subtree sizes are updated
 
     Parameter - y: A pointer to the node that needs to be rotated
     Return - A pointer to the new root of the rotated subtree
 */
-template <typename T>
-AVLNode<T>* AVLTree<T>::rotateRight(AVLNode<T>* y) {
-    AVLNode<T>* x = y->left;
-    AVLNode<T>* T2 = x->right;
+template <typename T, typename Aggregate, typename Allocator>
+AVLNode<T, Aggregate>* AVLTree<T, Aggregate, Allocator>::rotateRight(AVLNode<T, Aggregate>* y) {
+    AVLNode<T, Aggregate>* x = y->left;
+    AVLNode<T, Aggregate>* T2 = x->right;
 
     // Perform rotation
     x->right = y;
     y->left = T2;
+    x->parent = y->parent;
+    y->parent = x;
+    if (T2)
+        T2->parent = y;
 
-    // Update heights
-    y->height = max(getHeight(y->left), getHeight(y->right)) + 1;
-    x->height = max(getHeight(x->left), getHeight(x->right)) + 1;
+    // Update heights and sizes
+    updateNode(y);
+    updateNode(x);
 
     return x; // Return new root
 }
@@ -120,207 +361,516 @@ AVLNode<T>* AVLTree<T>::rotateRight(AVLNode<T>* y) {
     Performs a left rotation on the given node in the AVL tree
 
     This function rotates the given node ( x ) to the left, making its right child ( y ) the new root of the subtree. 
-    The left subtree of y is reassigned to x, and heights are updated accordingly.
+    The left subtree of y is reassigned to x, and heights and subtree sizes are updated accordingly.
 
     Parameter - x: A pointer to the node that needs to be rotated
     Return - A pointer to the new root of the rotated subtree
 */
-template <typename T>
-AVLNode<T>* AVLTree<T>::rotateLeft(AVLNode<T>* x) {
-    AVLNode<T>* y = x->right;
-    AVLNode<T>* T2 = y->left;
+template <typename T, typename Aggregate, typename Allocator>
+AVLNode<T, Aggregate>* AVLTree<T, Aggregate, Allocator>::rotateLeft(AVLNode<T, Aggregate>* x) {
+    AVLNode<T, Aggregate>* y = x->right;
+    AVLNode<T, Aggregate>* T2 = y->left;
 
     // Perform rotation
     y->left = x;
     x->right = T2;
+    y->parent = x->parent;
+    x->parent = y;
+    if (T2)
+        T2->parent = x;
 
-    // Update heights
-    x->height = max(getHeight(x->left), getHeight(x->right)) + 1;
-    y->height = max(getHeight(y->left), getHeight(y->right)) + 1;
+    // Update heights and sizes
+    updateNode(x);
+    updateNode(y);
 
     return y; // Return new root
 }
 
 /*
-    Performs a left rotation on the given node in the AVL tree
+    Updates the height of a node and restores its balance
 
-    This function rotates the given node ( x ) to the left, making its right child ( y ) the new root of the subtree.
-    The left subtree of y is reassigned to x, and heights are updated accordingly.
+    This function handles the four unbalanced cases (Left-Left, Left-Right, Right-Right, Right-Left)
+    using the balance factors of the children, so it works after both inserting and removing.
 
-    Parameter - x: A pointer to the node that needs to be rotated
-    Return - A pointer to the new root of the rotated subtree
+    Parameter - node: A pointer to the node whose subtrees may have changed height
+    Return - A pointer to the root of the (possibly rotated) subtree
 */
-template <typename T>
-AVLNode<T>* AVLTree<T>::insert(AVLNode<T>* node, T data) {
-    if (!node)
-        return new AVLNode<T>(data); // Create a new node if the current node is null
+template <typename T, typename Aggregate, typename Allocator>
+AVLNode<T, Aggregate>* AVLTree<T, Aggregate, Allocator>::rebalance(AVLNode<T, Aggregate>* node) {
+    updateNode(node);
+    int balance = getBalanceFactor(node);
 
-    // Insert data into the left or right subtree
-    if (data < node->data)
-        node->left = insert(node->left, data);
-    else if (data > node->data)
-        node->right = insert(node->right, data);
-    else
-        return node; // Duplicate keys are not allowed
+    if (balance > 1) {
+        if (getBalanceFactor(node->left) < 0) // Left-Right case
+            node->left = rotateLeft(node->left);
+        return rotateRight(node);             // Left-Left case
+    }
+    if (balance < -1) {
+        if (getBalanceFactor(node->right) > 0) // Right-Left case
+            node->right = rotateRight(node->right);
+        return rotateLeft(node);               // Right-Right case
+    }
+    return node;
+}
 
-    // Update the height of the current node
-    node->height = 1 + max(getHeight(node->left), getHeight(node->right));
+/*
+    Rebalances the tree along the path taken by an insert or remove
 
-    // Get the balance factor to check if the node is unbalanced
-    int balance = getBalanceFactor(node);
+    Each entry of the path is the link (root or a child pointer) that led to one node, from the root down.
+    The nodes are rebalanced from the deepest one up, and the walk stops as soon as a subtree keeps its
+    old height; above that point no rotation can be needed, so only the subtree sizes and aggregates are updated.
 
-    // Perform rotations if the node is unbalanced
-    if (balance > 1 && data < node->left->data) // Left-Left case
-        return rotateRight(node);
-    if (balance < -1 && data > node->right->data) // Right-Right case
-        return rotateLeft(node);
-    if (balance > 1 && data > node->left->data) { // Left-Right case
-        node->left = rotateLeft(node->left);
-        return rotateRight(node);
+    Parameter - path: The links followed from the root
+    Parameter - depth: The number of links in the path
+*/
+template <typename T, typename Aggregate, typename Allocator>
+void AVLTree<T, Aggregate, Allocator>::rebalancePath(AVLNode<T, Aggregate>** path[], int depth) {
+    int i = depth - 1;
+    for (; i >= 0; i--) {
+        AVLNode<T, Aggregate>* node = *path[i];
+        int oldHeight = node->height;
+        *path[i] = rebalance(node);
+        if ((*path[i])->height == oldHeight)
+            break;
     }
-    if (balance < -1 && data < node->right->data) { // Right-Left case
-        node->right = rotateRight(node->right);
-        return rotateLeft(node);
+    for (i--; i >= 0; i--) {
+        updateNode(*path[i]);
     }
+}
+
+/*
+    Links a new node into the AVL Tree
 
-    return node; // Return the (possibly updated) node
+    This function walks down from the root to the empty link where the node belongs, remembering the links
+    it followed, and then rebalances back up that path. Duplicate elements are not allowed.
+
+    Parameter - node: A new node holding the element to insert (owned by the tree afterwards)
+    Return - True if the node was linked in, false if an equal element exists (the node is deleted)
+*/
+template <typename T, typename Aggregate, typename Allocator>
+bool AVLTree<T, Aggregate, Allocator>::insertNode(AVLNode<T, Aggregate>* node) {
+    AVLNode<T, Aggregate>** path[AVL_TREE_MAX_HEIGHT];
+    int depth = 0;
+    AVLNode<T, Aggregate>** link = &root;
+    while (*link) {
+        path[depth++] = link;
+        if (node->data < (*link)->data)
+            link = &(*link)->left;
+        else if ((*link)->data < node->data)
+            link = &(*link)->right;
+        else {
+            pool->destroy(node); // Duplicate keys are not allowed
+            return false;
+        }
+    }
+
+    node->parent = depth > 0 ? *path[depth - 1] : nullptr;
+    *link = node;
+    rebalancePath(path, depth);
+    return true;
 }
 
 /*
-    Inserts a new node with the given data into the AVL Tree
+    Inserts the given data into the AVL Tree
 
-    This function inserts the data into the AVL Tree by calling the recursive insert function.
-    It ensures the tree remains balanced after insertion.
+    The data is copied (or moved, for the T&& overload) once into the new node and is not copied again
+    while the tree is searched and rebalanced.
 
     Parameter - data: The data to be inserted into the AVL Tree
+    Return - True if the data was inserted, false if an equal element is already in the tree
 */
-template <typename T>
-void AVLTree<T>::insert(T data) {
-    root = insert(root, data);
+template <typename T, typename Aggregate, typename Allocator>
+bool AVLTree<T, Aggregate, Allocator>::insert(const T& data) {
+    return insertNode(pool->create(data));
+}
+
+template <typename T, typename Aggregate, typename Allocator>
+bool AVLTree<T, Aggregate, Allocator>::insert(T&& data) {
+    return insertNode(pool->create(std::move(data)));
 }
 
 /*
-    Finds the node with the minimum value in the subtree rooted at the given node.
+    Constructs an element and inserts it into the AVL Tree
 
-    This function traverses the left subtree of the given node to find and return the node with the minimum value
+    The element is constructed directly in its node, so it is never copied or moved.
 
-    Parameter - node: A pointer to the root of the subtree to search
-    Return - A pointer to the node with the minimum value in the subtree
+    Parameter - args: The arguments passed to the element's constructor
+    Return - True if the element was inserted, false if an equal element is already in the tree
 */
-template <typename T>
-AVLNode<T>* AVLTree<T>::minValueNode(AVLNode<T>* node) const {
-    AVLNode<T>* current = node;
-    while (current && current->left)
-        current = current->left;
-    return current;
+template <typename T, typename Aggregate, typename Allocator>
+template <typename... Args>
+bool AVLTree<T, Aggregate, Allocator>::emplace(Args&&... args) {
+    return insertNode(pool->create(in_place, std::forward<Args>(args)...));
 }
 
 /*
-    Removes a node with the given data from the AVL Tree and balances the tree if necessary.
+    Builds a balanced subtree from a sorted range of items
 
-    This functions is called recursively and searches and removes the node containing the requested data.
-	After removing, it updates the heights of the affected nodes and rotates to maintain balance in the AVL tree.
-	It handles this 3 cases : nodes with no children, nodes with one child and nodes with two children (using the inorder successor)
+    This function makes the middle item the root of the subtree and builds the left and right subtrees
+    from the items before and after it, so no rotations are needed. Heights are set on the way back up.
 
-    Parameter - node: A pointer to the root of the subtree to search
-    Parameter - data: The data of the node to be removed
-    Return - A pointer to the root of the (possibly updated) subtree after removal and balancing
+    Parameter - items: The sorted items
+    Parameter - low: The index of the first item of the range
+    Parameter - high: The index of the last item of the range
+    Return - A pointer to the root of the new subtree, or nullptr if the range is empty
 */
-template <typename T>
-AVLNode<T>* AVLTree<T>::remove(AVLNode<T>* node, const T& data) {
-    if (!node)
-        return node; 
+template <typename T, typename Aggregate, typename Allocator>
+AVLNode<T, Aggregate>* AVLTree<T, Aggregate, Allocator>::build(const vector<T>& items, int low, int high) {
+    if (low > high)
+        return nullptr;
+
+    int mid = low + (high - low) / 2;
+    AVLNode<T, Aggregate>* node = pool->create(items[mid]);
+    node->left = build(items, low, mid - 1);
+    node->right = build(items, mid + 1, high);
+    if (node->left)
+        node->left->parent = node;
+    if (node->right)
+        node->right->parent = node;
+    updateNode(node);
+    return node;
+}
 
-    // Search for the node to be deleted
-    if (data < node->data)
-        node->left = remove(node->left, data);
-    else if (data > node->data)
-        node->right = remove(node->right, data);
-    else {
-        // Node with only one child or no child
-        if (!node->left || !node->right) {
-            AVLNode<T>* temp = node->left ? node->left : node->right;
-            if (!temp)
-                return nullptr; // No child case
-            *node = *temp;      // Copy the contents of the non-empty child
-            delete temp;
+/*
+    Replaces the contents of the AVL Tree with the given items
+
+    This function deletes the current nodes and builds a perfectly balanced tree from the items in one pass,
+    which is faster than inserting them one at a time. The items must be in ascending order with no duplicates
+    (the same order getAllItems returns).
+
+    Parameter - items: The sorted, duplicate-free items to store in the tree
+*/
+template <typename T, typename Aggregate, typename Allocator>
+void AVLTree<T, Aggregate, Allocator>::buildFromSorted(const vector<T>& items) {
+    clear();
+    root = build(items, 0, static_cast<int>(items.size()) - 1);
+}
+
+/*
+    Returns an iterator to the smallest element of the AVL Tree
+
+    Return - An iterator to the first element, or end() if the tree is empty
+*/
+template <typename T, typename Aggregate, typename Allocator>
+typename AVLTree<T, Aggregate, Allocator>::const_iterator AVLTree<T, Aggregate, Allocator>::begin() const {
+    AVLNode<T, Aggregate>* node = root;
+    while (node && node->left)
+        node = node->left;
+    return const_iterator(node, this);
+}
+
+/*
+    Finds the smallest element that is not less than a key
+
+    This function walks down from the root once, remembering the last node where it had to go left.
+
+    Parameter - key: The value or key to compare against
+    Return - An iterator to the first element >= key, or end() if every element is smaller
+*/
+template <typename T, typename Aggregate, typename Allocator>
+template <typename Key>
+typename AVLTree<T, Aggregate, Allocator>::const_iterator AVLTree<T, Aggregate, Allocator>::lowerBound(const Key& key) const {
+    AVLNode<T, Aggregate>* node = root;
+    AVLNode<T, Aggregate>* best = nullptr;
+    while (node) {
+        if (node->data < key) {
+            node = node->right;
         }
         else {
-            // Node with two children: get the inorder successor (smallest in the right subtree)
-            AVLNode<T>* temp = minValueNode(node->right);
-            node->data = temp->data; // Copy the inorder successor's data to this node
-            node->right = remove(node->right, temp->data); // Delete the inorder successor
+            best = node;
+            node = node->left;
         }
     }
+    return const_iterator(best, this);
+}
 
-    // Update the height of the current node
-    node->height = 1 + max(getHeight(node->left), getHeight(node->right));
+/*
+    Finds the smallest element that is greater than a key
 
-    // Get the balance factor to check if the node is unbalanced
-    int balance = getBalanceFactor(node);
+    Parameter - key: The value or key to compare against
+    Return - An iterator to the first element > key, or end() if no element is greater
+*/
+template <typename T, typename Aggregate, typename Allocator>
+template <typename Key>
+typename AVLTree<T, Aggregate, Allocator>::const_iterator AVLTree<T, Aggregate, Allocator>::upperBound(const Key& key) const {
+    AVLNode<T, Aggregate>* node = root;
+    AVLNode<T, Aggregate>* best = nullptr;
+    while (node) {
+        if (key < node->data) {
+            best = node;
+            node = node->left;
+        }
+        else {
+            node = node->right;
+        }
+    }
+    return const_iterator(best, this);
+}
+
+/*
+    Gets the elements between two keys
+
+    The range is found with two walks from the root; iterating over it then costs O(1) per element
+    (amortized), so reading k elements costs O(log n + k).
+
+    Parameter - low: The smallest value (or key) to include
+    Parameter - high: The largest value (or key) to include
+    Return - A range of the elements >= low and <= high, in ascending order (empty if high < low)
+*/
+template <typename T, typename Aggregate, typename Allocator>
+template <typename Key>
+typename AVLTree<T, Aggregate, Allocator>::Range AVLTree<T, Aggregate, Allocator>::range(const Key& low, const Key& high) const {
+    if (high < low)
+        return Range(end(), end());
+    return Range(lowerBound(low), upperBound(high));
+}
+
+/*
+    Finds the k-th smallest element of the AVL Tree
+
+    This function walks down from the root, using the size of each left subtree to decide whether
+    the element is on the left, at the node, or on the right.
+
+    Parameter - k: The position of the element in ascending order, starting at 0
+    Return - An iterator to the element, or end() if k < 0 or k >= size()
+*/
+template <typename T, typename Aggregate, typename Allocator>
+typename AVLTree<T, Aggregate, Allocator>::const_iterator AVLTree<T, Aggregate, Allocator>::select(int k) const {
+    if (k < 0 || k >= size())
+        return end();
+
+    AVLNode<T, Aggregate>* node = root;
+    while (true) {
+        int leftSize = getSize(node->left);
+        if (k < leftSize) {
+            node = node->left;
+        }
+        else if (k == leftSize) {
+            return const_iterator(node, this);
+        }
+        else {
+            k -= leftSize + 1;
+            node = node->right;
+        }
+    }
+}
+
+/*
+    Counts the elements that are less than a key
+
+    This function walks down from the root, adding the left subtree and the node itself every time
+    the walk goes right. The result is also the position lowerBound(key) would have in ascending order.
+
+    Parameter - key: The value or key to compare against
+    Return - The number of elements < key
+*/
+template <typename T, typename Aggregate, typename Allocator>
+template <typename Key>
+int AVLTree<T, Aggregate, Allocator>::rank(const Key& key) const {
+    int count = 0;
+    AVLNode<T, Aggregate>* node = root;
+    while (node) {
+        if (node->data < key) {
+            count += getSize(node->left) + 1;
+            node = node->right;
+        }
+        else {
+            node = node->left;
+        }
+    }
+    return count;
+}
+
+/*
+    Summarizes the elements between two keys
+
+    This function walks down to the first node inside the range, then follows the lower edge of the range
+    down its left subtree and the upper edge down its right subtree. Every subtree that lies wholly inside
+    the range hangs off one of those two paths and is added as a whole from its root's aggregate, so only
+    O(log n) nodes are read however many elements are in the range.
 
-    // Perform rotations if the node is unbalanced
-    if (balance > 1 && getBalanceFactor(node->left) >= 0) // Left-Left case
-        return rotateRight(node);
-    if (balance > 1 && getBalanceFactor(node->left) < 0) { // Left-Right case
-        node->left = rotateLeft(node->left);
-        return rotateRight(node);
+    Parameter - low: The smallest value (or key) to include
+    Parameter - high: The largest value (or key) to include
+    Return - The aggregate of the elements >= low and <= high (the empty aggregate if there are none)
+*/
+template <typename T, typename Aggregate, typename Allocator>
+template <typename Key>
+Aggregate AVLTree<T, Aggregate, Allocator>::aggregate(const Key& low, const Key& high) const {
+    Aggregate result;
+    Aggregate element;
+
+    // Find the highest node inside the range, every other node in the range is below it
+    AVLNode<T, Aggregate>* split = root;
+    while (split) {
+        if (split->data < low)
+            split = split->right;
+        else if (high < split->data)
+            split = split->left;
+        else
+            break;
     }
-    if (balance < -1 && getBalanceFactor(node->right) <= 0) // Right-Right case
-        return rotateLeft(node);
-    if (balance < -1 && getBalanceFactor(node->right) > 0) { // Right-Left case
-        node->right = rotateRight(node->right);
-        return rotateLeft(node);
+    if (!split)
+        return result;
+
+    element.reset(split->data);
+    result.merge(element);
+
+    // Lower edge: a node >= low is included together with its whole right subtree
+    for (AVLNode<T, Aggregate>* node = split->left; node; ) {
+        if (node->data < low) {
+            node = node->right;
+        }
+        else {
+            element.reset(node->data);
+            result.merge(element);
+            if (node->right)
+                result.merge(*node->right);
+            node = node->left;
+        }
     }
 
-    return node; // Return the (possibly updated) node
+    // Upper edge: a node <= high is included together with its whole left subtree
+    for (AVLNode<T, Aggregate>* node = split->right; node; ) {
+        if (high < node->data) {
+            node = node->left;
+        }
+        else {
+            element.reset(node->data);
+            result.merge(element);
+            if (node->left)
+                result.merge(*node->left);
+            node = node->right;
+        }
+    }
+    return result;
 }
 
 /*
-    Removes a node with the given data from the AVL Tree.
+    Recomputes the aggregates that include an element
 
-	This function is called doing the removing of the node from the AVL Tree
-    It make sures the tree is balanced after removing
+    The aggregates are only updated by the tree itself, so when a field they read changes outside the tree
+    (e.g. the rating of the record an element points to), this function must be called for that element.
+    The change must not affect the element's position in the ordering.
 
-    Parameter - data: The data of the node to be removed from the AVL Tree
+    Parameter - key: The element (or a key comparable with it) whose summarized fields have changed
+    Return - True if the element was found, false otherwise
 */
-template <typename T>
-void AVLTree<T>::remove(const T& data) {
-    root = remove(root, data);
+template <typename T, typename Aggregate, typename Allocator>
+template <typename Key>
+bool AVLTree<T, Aggregate, Allocator>::refresh(const Key& key) {
+    AVLNode<T, Aggregate>* node = root;
+    while (node && (key < node->data || node->data < key))
+        node = key < node->data ? node->left : node->right;
+    if (!node)
+        return false;
+
+    for (; node; node = node->parent) {
+        updateNode(node);
+    }
+    return true;
 }
 
 /*
-    Finds a node with the given data in the AVL Tree.
+    Visits the elements in ascending order from a starting value
 
-    This functions recursively searches for the node with the requested data.
-	It traveses the tree based on the comparison of the data with the current node's data,searching the left and right subtree accordingly.
+    This function starts at the first element not less than low and follows the iterators from there,
+    so visiting k elements costs O(log n + k).
 
-    Parameter - node: A pointer to the root of the subtree to search
-    Parameter - data: The data to search for in the AVL Tree
-    Return - A pointer to the node containing the data, or nullptr if the data is not found
+    Parameter - low: The smallest value (or key) to visit
+    Parameter - visit: A callable taking a const T& and returning true to continue or false to stop
 */
-template <typename T>
-AVLNode<T>* AVLTree<T>::find(AVLNode<T>* node, const T& data) const {
-    if (!node || node->data == data)
-        return node; // Base case: node found or not found
-    if (data < node->data)
-        return find(node->left, data); // Search in the left subtree
-    return find(node->right, data);    // Search in the right subtree
+template <typename T, typename Aggregate, typename Allocator>
+template <typename Key, typename Visitor>
+void AVLTree<T, Aggregate, Allocator>::visitFrom(const Key& low, Visitor visit) const {
+    for (const_iterator it = lowerBound(low); it != end(); ++it) {
+        if (!visit(*it))
+            return;
+    }
 }
 
 /*
-    Finds data in the AVL Tree and returns a pointer to it.
+    Removes the element equal to a key from the AVL Tree and balances the tree if necessary.
 
-    This function searches for the given data in the Tree by calling a recursive find function.
-	If the data is found, it returns a pointer to the data else it returns a nullptr
+    This function searches for the node iteratively, remembering the links it followed.
+	It handles this 3 cases : nodes with no children, nodes with one child and nodes with two children.
+	A node with two children takes over its inorder successor's data (moved, not copied) and the successor's
+	node is unlinked instead. The heights along the path are then updated and rotated back into balance.
 
-    Parameter - data: The data to search for in the AVL Tree
+    Parameter - key: The data (or a key comparable with it) of the element to be removed
+    Return - True if an element was removed, false if no element is equal to key
+*/
+template <typename T, typename Aggregate, typename Allocator>
+template <typename Key>
+bool AVLTree<T, Aggregate, Allocator>::remove(const Key& key) {
+    AVLNode<T, Aggregate>** path[AVL_TREE_MAX_HEIGHT];
+    int depth = 0;
+    AVLNode<T, Aggregate>** link = &root;
+    while (*link) {
+        if (key < (*link)->data) {
+            path[depth++] = link;
+            link = &(*link)->left;
+        }
+        else if ((*link)->data < key) {
+            path[depth++] = link;
+            link = &(*link)->right;
+        }
+        else
+            break;
+    }
+    if (!*link)
+        return false;
+
+    AVLNode<T, Aggregate>* node = *link;
+    if (node->left && node->right) {
+        // Node with two children: find the inorder successor (smallest in the right subtree)
+        path[depth++] = link;
+        AVLNode<T, Aggregate>** successorLink = &node->right;
+        while ((*successorLink)->left) {
+            path[depth++] = successorLink;
+            successorLink = &(*successorLink)->left;
+        }
+        AVLNode<T, Aggregate>* successor = *successorLink;
+        node->data = std::move(successor->data);
+        if (successor->right)
+            successor->right->parent = successor->parent;
+        *successorLink = successor->right;
+        pool->destroy(successor);
+    }
+    else {
+        // Node with only one child or no child
+        AVLNode<T, Aggregate>* child = node->left ? node->left : node->right;
+        if (child)
+            child->parent = node->parent;
+        *link = child;
+        pool->destroy(node);
+    }
+
+    rebalancePath(path, depth);
+    return true;
+}
+
+/*
+    Finds the element equal to a key in the AVL Tree and returns a pointer to it.
+
+    This function walks down from the root in a loop, going left or right based on the comparison of the key
+	with the current node's data. Only operator< is used, so key can be a T or anything comparable with T.
+
+    Parameter - key: The data (or a key comparable with it) to search for in the AVL Tree
     Return - A pointer to the data if found, otherwise nullptr
 */
-template <typename T>
-T* AVLTree<T>::find(const T& data) const {
-    AVLNode<T>* foundNode = find(root, data);
-    return foundNode ? &(foundNode->data) : nullptr;
+template <typename T, typename Aggregate, typename Allocator>
+template <typename Key>
+T* AVLTree<T, Aggregate, Allocator>::find(const Key& key) const {
+    AVLNode<T, Aggregate>* node = root;
+    while (node) {
+        if (key < node->data)
+            node = node->left;
+        else if (node->data < key)
+            node = node->right;
+        else
+            return &node->data;
+    }
+    return nullptr;
 }
 
 /*
@@ -332,8 +882,8 @@ T* AVLTree<T>::find(const T& data) const {
     Parameter - node: A pointer to the root of the subtree to traverse
     Parameter - items: A reference to a vector to store the elements of the tree
 */
-template <typename T>
-void AVLTree<T>::inOrderTraversal(AVLNode<T>* node, vector<T>& items) const {
+template <typename T, typename Aggregate, typename Allocator>
+void AVLTree<T, Aggregate, Allocator>::inOrderTraversal(AVLNode<T, Aggregate>* node, vector<T>& items) const {
     if (node) {
         inOrderTraversal(node->left, items);  // Traverse left subtree
         items.push_back(node->data);          // Visit node
@@ -349,8 +899,8 @@ void AVLTree<T>::inOrderTraversal(AVLNode<T>* node, vector<T>& items) const {
 
     Return - A vector containing all elements of the AVL Tree in sorted order
 */
-template <typename T>
-vector<T> AVLTree<T>::getAllItems() const {
+template <typename T, typename Aggregate, typename Allocator>
+vector<T> AVLTree<T, Aggregate, Allocator>::getAllItems() const {
     vector<T> items;
     inOrderTraversal(root, items);
     return items;
@@ -363,19 +913,53 @@ vector<T> AVLTree<T>::getAllItems() const {
 
     Parameter - node: A pointer to the root of the subtree to delete
 */
-template <typename T>
-void AVLTree<T>::destroy(AVLNode<T>* node) {
+template <typename T, typename Aggregate, typename Allocator>
+void AVLTree<T, Aggregate, Allocator>::destroy(AVLNode<T, Aggregate>* node) {
     if (node) {
         destroy(node->left);  // Delete left subtree
         destroy(node->right); // Delete right subtree
-        delete node;          // Delete current node
+        pool->destroy(node);  // Delete current node
+    }
+}
+
+/*
+    Runs the destructor of every node in a subtree without giving the memory back.
+
+    Parameter - node: A pointer to the root of the subtree
+*/
+template <typename T, typename Aggregate, typename Allocator>
+void AVLTree<T, Aggregate, Allocator>::destroyInPlace(AVLNode<T, Aggregate>* node) {
+    if (node) {
+        destroyInPlace(node->left);
+        destroyInPlace(node->right);
+        node->~AVLNode<T, Aggregate>();
+    }
+}
+
+/*
+    Deletes all nodes in the AVL Tree.
+
+    A tree using its own pool releases the pool's chunks in one go; the nodes are only visited when
+    their elements have destructors to run. A tree using a shared pool returns its nodes one at a time,
+    since the other trees' nodes live in the same chunks.
+*/
+template <typename T, typename Aggregate, typename Allocator>
+void AVLTree<T, Aggregate, Allocator>::clear() {
+    if (pool == &ownPool) {
+        if (!is_trivially_destructible<AVLNode<T, Aggregate>>::value)
+            destroyInPlace(root);
+        ownPool.releaseAll();
+    }
+    else {
+        destroy(root);
     }
+    root = nullptr;
 }
 
 // Destructor for the AVL Tree.
-template <typename T>
-AVLTree<T>::~AVLTree() {
-    destroy(root);
+template <typename T, typename Aggregate, typename Allocator>
+AVLTree<T, Aggregate, Allocator>::~AVLTree() {
+    clear();
 }
 
 /*
@@ -385,8 +969,8 @@ AVLTree<T>::~AVLTree() {
 
     Output - Prints each element of the AVL Tree to the standard output, one per line
 */
-template <typename T>
-void AVLTree<T>::displayInOrder() const {
+template <typename T, typename Aggregate, typename Allocator>
+void AVLTree<T, Aggregate, Allocator>::displayInOrder() const {
     vector<T> items = getAllItems();
     for (const auto& item : items) {
         cout << item << endl;
@@ -3,20 +3,22 @@
 #include <iostream>
 #include <vector>
 
+#include "RecordId.h"
+
 using namespace std;
 
 class Movie;
 
 class Actor {
 public:
-    string id;
+    RecordId id;
     string name;
     int birthYear;
     double rating;    
     int noOfTimesRated; 
     vector<Movie*> movies;
 
-    Actor(string id, string name, int birthYear, double rating = 0.0, int noOfTimesRated = 0)
+    Actor(RecordId id, string name, int birthYear, double rating = 0.0, int noOfTimesRated = 0)
         : id(id), name(name), birthYear(birthYear), rating(rating), noOfTimesRated(noOfTimesRated) {
     }
 
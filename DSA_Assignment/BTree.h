@@ -0,0 +1,886 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include <new>
+#include <utility>
+#include <type_traits>
+#include <iterator>
+#include <cstddef>
+
+#include "NodePool.h"
+
+using namespace std;
+
+#ifndef BTREE_NODE_BYTES
+#define BTREE_NODE_BYTES 256   // Target size of one node (four 64-byte cache lines)
+#endif
+
+// Largest height a B-tree can reach in memory (every node below the root has at least three children)
+const int BTREE_MAX_HEIGHT = 40;
+
+/*
+    BTree class implementation (B+ tree, a cache-friendly alternative to AVLTree)
+
+    Elements are kept in sorted arrays inside leaf nodes of about BTREE_NODE_BYTES each, and the leaves are
+    linked to each other in order. Internal nodes only hold separator copies of elements and child pointers,
+    so a lookup reads a handful of nodes from top to bottom and compares against neighbouring elements in
+    the same cache lines, instead of following one pointer per comparison as a binary tree does.
+    Scans walk the leaf arrays one after another.
+
+    The class offers the same interface as AVLTree for inserting, removing, finding, building from sorted
+    items, iterating and visiting ranges, so an ordered index can switch between the two through a template
+    parameter. It does not keep subtree sizes or aggregates, so it has no select, rank or aggregate.
+    Lookups only use operator<, and accept any key type that can be compared with T in both directions.
+    T must be copy constructible (separators are copies) and move constructible.
+*/
+template <typename T>
+class BTree {
+private:
+    // Number of elements per leaf and keys per internal node that fit in BTREE_NODE_BYTES (at least 4)
+    static const int LEAF_CAPACITY = (BTREE_NODE_BYTES - 32) / static_cast<int>(sizeof(T)) >= 4
+        ? (BTREE_NODE_BYTES - 32) / static_cast<int>(sizeof(T)) : 4;
+    static const int INTERNAL_CAPACITY = (BTREE_NODE_BYTES - 24) / static_cast<int>(sizeof(T) + sizeof(void*)) >= 4
+        ? (BTREE_NODE_BYTES - 24) / static_cast<int>(sizeof(T) + sizeof(void*)) : 4;
+
+    // A node below the root with fewer entries than this borrows from or merges with a sibling
+    static const int LEAF_MINIMUM = LEAF_CAPACITY / 2;
+    static const int INTERNAL_MINIMUM = INTERNAL_CAPACITY / 2;
+
+    struct Node {
+        bool isLeaf;
+        int count;      // Elements in a leaf, keys in an internal node (which has count + 1 children)
+    };
+
+    // Leaf node: a sorted array of elements, linked to its neighbours
+    struct Leaf : Node {
+        Leaf* prev;
+        Leaf* next;
+        alignas(T) unsigned char storage[sizeof(T) * LEAF_CAPACITY];
+
+        Leaf() : prev(nullptr), next(nullptr) { this->isLeaf = true; this->count = 0; }
+        T* items() { return reinterpret_cast<T*>(storage); }
+        const T* items() const { return reinterpret_cast<const T*>(storage); }
+    };
+
+    // Internal node: child i holds the elements e with keys[i - 1] <= e < keys[i]
+    struct Internal : Node {
+        Node* children[INTERNAL_CAPACITY + 1];
+        alignas(T) unsigned char storage[sizeof(T) * INTERNAL_CAPACITY];
+
+        Internal() { this->isLeaf = false; this->count = 0; }
+        T* keys() { return reinterpret_cast<T*>(storage); }
+        const T* keys() const { return reinterpret_cast<const T*>(storage); }
+    };
+
+    Node* root;                 // nullptr when the tree is empty
+    int count;
+    NodePool<Leaf> leafPool;
+    NodePool<Internal> internalPool;
+
+    // Array helpers for elements in raw node storage
+    static void insertAt(T* array, int size, int position, T&& value);
+    static void eraseAt(T* array, int size, int position);
+    static void moveRange(T* from, T* to, int n);
+    static void replaceAt(T* array, int position, const T& value);
+
+    // Inserts a key and the child to its right into an internal node with room for them
+    static void insertIntoInternal(Internal* node, int position, T&& key, Node* child);
+
+    // Removes key position and the child to its right from an internal node
+    static void removeFromInternal(Internal* node, int position);
+
+    // Returns the child of an internal node that can hold key
+    template <typename Key>
+    static int childIndex(const Internal* node, const Key& key);
+
+    // Returns the leaf that can hold key
+    template <typename Key>
+    const Leaf* findLeaf(const Key& key) const;
+
+    // Returns the first and last leaves
+    const Leaf* firstLeaf() const;
+    const Leaf* lastLeaf() const;
+
+    // Adds a moved-in element, returns false if an equal element exists
+    bool insertValue(T&& value);
+
+    // Puts a new key and right child into the parent at the given depth of the path, splitting upwards if needed
+    void insertIntoParent(Internal* path[], int indexes[], int depth, T&& key, Node* child);
+
+    // Restores the minimum size of a leaf or internal node by borrowing from or merging with a sibling
+    void fixLeaf(Leaf* leaf, Internal* parent, int index);
+    void fixInternal(Internal* node, Internal* parent, int index);
+
+    // Destroys the elements and keys of a subtree (the nodes are freed with the pools)
+    void destroyContents(Node* node);
+
+public:
+    /*
+        Bidirectional iterator over the elements in ascending order
+
+        The elements cannot be changed through the iterator, since that could break the ordering.
+        An iterator is invalidated by any insert or remove, since elements move inside and between leaves.
+    */
+    class const_iterator {
+    private:
+        const Leaf* leaf;       // Current leaf, nullptr at end()
+        int index;              // Position in the leaf
+        const BTree* tree;      // Tree being walked, so that --end() can find the last element
+
+        friend class BTree;
+        const_iterator(const Leaf* leaf, int index, const BTree* tree) : leaf(leaf), index(index), tree(tree) {}
+
+    public:
+        typedef bidirectional_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef ptrdiff_t difference_type;
+        typedef const T* pointer;
+        typedef const T& reference;
+
+        const_iterator() : leaf(nullptr), index(0), tree(nullptr) {}
+
+        const T& operator*() const { return leaf->items()[index]; }
+        const T* operator->() const { return &leaf->items()[index]; }
+
+        const_iterator& operator++() {
+            if (++index == leaf->count) {
+                leaf = leaf->next;
+                index = 0;
+            }
+            return *this;
+        }
+
+        const_iterator& operator--() {
+            if (!leaf) {
+                leaf = tree->lastLeaf();
+                index = leaf ? leaf->count - 1 : 0;
+            }
+            else if (index > 0) {
+                index--;
+            }
+            else {
+                leaf = leaf->prev;
+                index = leaf ? leaf->count - 1 : 0;
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int) { const_iterator old = *this; ++*this; return old; }
+        const_iterator operator--(int) { const_iterator old = *this; --*this; return old; }
+
+        bool operator==(const const_iterator& other) const { return leaf == other.leaf && index == other.index; }
+        bool operator!=(const const_iterator& other) const { return !(*this == other); }
+    };
+    typedef const_iterator iterator;
+
+    // A pair of iterators that can be used in a range-based for loop
+    class Range {
+    private:
+        const_iterator first, last;
+
+    public:
+        Range(const_iterator first, const_iterator last) : first(first), last(last) {}
+        const_iterator begin() const { return first; }
+        const_iterator end() const { return last; }
+        bool empty() const { return first == last; }
+    };
+
+    BTree() : root(nullptr), count(0) {}   // Constructor
+    ~BTree() { clear(); }                    // Destructor
+
+    // The tree owns its nodes, so it cannot be copied
+    BTree(const BTree&) = delete;
+    BTree& operator=(const BTree&) = delete;
+
+    // Insert an element, returns false if an equal element is already in the tree
+    bool insert(const T& data);
+    bool insert(T&& data);
+
+    // Constructs an element from args and inserts it, returns false if it is a duplicate
+    template <typename... Args>
+    bool emplace(Args&&... args);
+
+    // Removes the element equal to key, returns false if there is none
+    template <typename Key>
+    bool remove(const Key& key);
+
+    // Returns the element equal to key, or nullptr
+    template <typename Key>
+    T* find(const Key& key) const;
+
+    // Replaces the contents with a tree built from sorted, duplicate-free items in O(n)
+    void buildFromSorted(const vector<T>& items);
+
+    // Delete all elements
+    void clear();
+
+    // Iterators over every element in ascending order
+    const_iterator begin() const { return const_iterator(firstLeaf(), 0, this); }
+    const_iterator end() const { return const_iterator(nullptr, 0, this); }
+
+    // Returns the first element not less than key, or end() if there is none
+    template <typename Key>
+    const_iterator lowerBound(const Key& key) const;
+
+    // Returns the first element greater than key, or end() if there is none
+    template <typename Key>
+    const_iterator upperBound(const Key& key) const;
+
+    // Returns the elements from low to high (both included) in ascending order
+    template <typename Key>
+    Range range(const Key& low, const Key& high) const;
+
+    // Calls visit(element) in ascending order starting at the first element not less than low,
+    // until visit returns false or the elements run out
+    template <typename Key, typename Visitor>
+    void visitFrom(const Key& low, Visitor visit) const;
+
+    // Returns the number of elements in the tree
+    int size() const { return count; }
+
+    // Display all elements in sorted order
+    void displayInOrder() const;
+
+    // Get all elements in the tree in sorted order
+    vector<T> getAllItems() const;
+};
+
+
+// Moves the elements from position onwards up by one and moves value into the gap
+template <typename T>
+void BTree<T>::insertAt(T* array, int size, int position, T&& value) {
+    for (int i = size; i > position; i--) {
+        new (&array[i]) T(std::move(array[i - 1]));
+        array[i - 1].~T();
+    }
+    new (&array[position]) T(std::move(value));
+}
+
+// Destroys the element at position and moves the ones after it down by one
+template <typename T>
+void BTree<T>::eraseAt(T* array, int size, int position) {
+    array[position].~T();
+    for (int i = position; i < size - 1; i++) {
+        new (&array[i]) T(std::move(array[i + 1]));
+        array[i + 1].~T();
+    }
+}
+
+// Moves n elements to uninitialized storage, leaving the source slots uninitialized
+template <typename T>
+void BTree<T>::moveRange(T* from, T* to, int n) {
+    for (int i = 0; i < n; i++) {
+        new (&to[i]) T(std::move(from[i]));
+        from[i].~T();
+    }
+}
+
+// Replaces the element at position with a copy of value
+template <typename T>
+void BTree<T>::replaceAt(T* array, int position, const T& value) {
+    array[position].~T();
+    new (&array[position]) T(value);
+}
+
+template <typename T>
+void BTree<T>::insertIntoInternal(Internal* node, int position, T&& key, Node* child) {
+    insertAt(node->keys(), node->count, position, std::move(key));
+    for (int i = node->count + 1; i > position + 1; i--) {
+        node->children[i] = node->children[i - 1];
+    }
+    node->children[position + 1] = child;
+    node->count++;
+}
+
+template <typename T>
+void BTree<T>::removeFromInternal(Internal* node, int position) {
+    eraseAt(node->keys(), node->count, position);
+    for (int i = position + 1; i < node->count; i++) {
+        node->children[i] = node->children[i + 1];
+    }
+    node->count--;
+}
+
+/*
+    Chooses the child of an internal node to descend into
+
+    The keys of a node share a few cache lines, so they are scanned in order rather than binary searched.
+
+    Parameter - node: The internal node
+    Parameter - key: The value or key being searched for
+    Return - The index of the first key greater than key (the child that can hold key)
+*/
+template <typename T>
+template <typename Key>
+int BTree<T>::childIndex(const Internal* node, const Key& key) {
+    int i = 0;
+    while (i < node->count && !(key < node->keys()[i]))
+        i++;
+    return i;
+}
+
+template <typename T>
+template <typename Key>
+const typename BTree<T>::Leaf* BTree<T>::findLeaf(const Key& key) const {
+    const Node* node = root;
+    while (node && !node->isLeaf) {
+        const Internal* internal = static_cast<const Internal*>(node);
+        node = internal->children[childIndex(internal, key)];
+    }
+    return static_cast<const Leaf*>(node);
+}
+
+template <typename T>
+const typename BTree<T>::Leaf* BTree<T>::firstLeaf() const {
+    const Node* node = root;
+    while (node && !node->isLeaf)
+        node = static_cast<const Internal*>(node)->children[0];
+    return static_cast<const Leaf*>(node);
+}
+
+template <typename T>
+const typename BTree<T>::Leaf* BTree<T>::lastLeaf() const {
+    const Node* node = root;
+    while (node && !node->isLeaf)
+        node = static_cast<const Internal*>(node)->children[node->count];
+    return static_cast<const Leaf*>(node);
+}
+
+/*
+    Inserts an element into the B-tree
+
+    This function walks down to the leaf that can hold the element, remembering the path. If the leaf is full
+    it is split in half and a copy of the right half's first element is added to the parent as a separator;
+    a full parent is split the same way, up to the root.
+
+    Parameter - value: The element to insert (moved into the tree)
+    Return - True if the element was inserted, false if an equal element is already in the tree
+*/
+template <typename T>
+bool BTree<T>::insertValue(T&& value) {
+    if (!root) {
+        Leaf* leaf = leafPool.create();
+        insertAt(leaf->items(), 0, 0, std::move(value));
+        leaf->count = 1;
+        root = leaf;
+        count = 1;
+        return true;
+    }
+
+    Internal* path[BTREE_MAX_HEIGHT];
+    int indexes[BTREE_MAX_HEIGHT];
+    int depth = 0;
+    Node* node = root;
+    while (!node->isLeaf) {
+        Internal* internal = static_cast<Internal*>(node);
+        int index = childIndex(internal, value);
+        path[depth] = internal;
+        indexes[depth] = index;
+        depth++;
+        node = internal->children[index];
+    }
+
+    Leaf* leaf = static_cast<Leaf*>(node);
+    int position = 0;
+    while (position < leaf->count && leaf->items()[position] < value)
+        position++;
+    if (position < leaf->count && !(value < leaf->items()[position]))
+        return false; // Duplicate keys are not allowed
+
+    count++;
+    if (leaf->count < LEAF_CAPACITY) {
+        insertAt(leaf->items(), leaf->count, position, std::move(value));
+        leaf->count++;
+        return true;
+    }
+
+    // Split the full leaf, the upper half goes to a new leaf on its right
+    Leaf* right = leafPool.create();
+    int leftCount = (LEAF_CAPACITY + 1) / 2;
+    moveRange(leaf->items() + leftCount, right->items(), LEAF_CAPACITY - leftCount);
+    right->count = LEAF_CAPACITY - leftCount;
+    leaf->count = leftCount;
+    right->next = leaf->next;
+    if (right->next)
+        right->next->prev = right;
+    right->prev = leaf;
+    leaf->next = right;
+
+    if (position <= leftCount) {
+        insertAt(leaf->items(), leaf->count, position, std::move(value));
+        leaf->count++;
+    }
+    else {
+        insertAt(right->items(), right->count, position - leftCount, std::move(value));
+        right->count++;
+    }
+
+    insertIntoParent(path, indexes, depth, T(right->items()[0]), right);
+    return true;
+}
+
+/*
+    Adds a separator and the new node to its right to the parent of a node that was split
+
+    Parameter - path: The internal nodes from the root down to the split node's parent
+    Parameter - indexes: The child taken in each node of the path
+    Parameter - depth: The number of nodes in the path (0 if the split node is the root)
+    Parameter - key: The separator (the smallest element under child)
+    Parameter - child: The new node
+*/
+template <typename T>
+void BTree<T>::insertIntoParent(Internal* path[], int indexes[], int depth, T&& key, Node* child) {
+    if (depth == 0) {
+        Internal* newRoot = internalPool.create();
+        newRoot->children[0] = root;
+        newRoot->children[1] = child;
+        new (&newRoot->keys()[0]) T(std::move(key));
+        newRoot->count = 1;
+        root = newRoot;
+        return;
+    }
+
+    Internal* parent = path[depth - 1];
+    int index = indexes[depth - 1];
+    if (parent->count < INTERNAL_CAPACITY) {
+        insertIntoInternal(parent, index, std::move(key), child);
+        return;
+    }
+
+    // Split the full parent around its middle key, which moves up a level
+    Internal* sibling = internalPool.create();
+    int middle = INTERNAL_CAPACITY / 2;
+    T promoted(std::move(parent->keys()[middle]));
+    parent->keys()[middle].~T();
+    moveRange(parent->keys() + middle + 1, sibling->keys(), INTERNAL_CAPACITY - middle - 1);
+    for (int i = middle + 1; i <= INTERNAL_CAPACITY; i++) {
+        sibling->children[i - middle - 1] = parent->children[i];
+    }
+    sibling->count = INTERNAL_CAPACITY - middle - 1;
+    parent->count = middle;
+
+    if (index <= middle)
+        insertIntoInternal(parent, index, std::move(key), child);
+    else
+        insertIntoInternal(sibling, index - middle - 1, std::move(key), child);
+
+    insertIntoParent(path, indexes, depth - 1, std::move(promoted), sibling);
+}
+
+template <typename T>
+bool BTree<T>::insert(const T& data) {
+    return insertValue(T(data));
+}
+
+template <typename T>
+bool BTree<T>::insert(T&& data) {
+    return insertValue(std::move(data));
+}
+
+template <typename T>
+template <typename... Args>
+bool BTree<T>::emplace(Args&&... args) {
+    return insertValue(T(std::forward<Args>(args)...));
+}
+
+/*
+    Refills a leaf that has fewer than LEAF_MINIMUM elements
+
+    The leaf takes an element from a sibling with some to spare, or else is merged with a sibling.
+    A merge removes a separator from the parent, which may then need fixing itself.
+
+    Parameter - leaf: The leaf that is too small
+    Parameter - parent: Its parent
+    Parameter - index: The position of the leaf among the parent's children
+*/
+template <typename T>
+void BTree<T>::fixLeaf(Leaf* leaf, Internal* parent, int index) {
+    Leaf* left = index > 0 ? static_cast<Leaf*>(parent->children[index - 1]) : nullptr;
+    Leaf* right = index < parent->count ? static_cast<Leaf*>(parent->children[index + 1]) : nullptr;
+
+    if (left && left->count > LEAF_MINIMUM) {
+        // Take the left sibling's last element
+        insertAt(leaf->items(), leaf->count, 0, std::move(left->items()[left->count - 1]));
+        leaf->count++;
+        left->items()[left->count - 1].~T();
+        left->count--;
+        replaceAt(parent->keys(), index - 1, leaf->items()[0]);
+    }
+    else if (right && right->count > LEAF_MINIMUM) {
+        // Take the right sibling's first element
+        new (&leaf->items()[leaf->count]) T(std::move(right->items()[0]));
+        leaf->count++;
+        eraseAt(right->items(), right->count, 0);
+        right->count--;
+        replaceAt(parent->keys(), index, right->items()[0]);
+    }
+    else {
+        // Merge the right one of the pair into the left one
+        Leaf* into = left ? left : leaf;
+        Leaf* from = left ? leaf : right;
+        moveRange(from->items(), into->items() + into->count, from->count);
+        into->count += from->count;
+        from->count = 0;
+        into->next = from->next;
+        if (into->next)
+            into->next->prev = into;
+        removeFromInternal(parent, left ? index - 1 : index);
+        leafPool.destroy(from);
+    }
+}
+
+/*
+    Refills an internal node that has fewer than INTERNAL_MINIMUM keys
+
+    The node rotates a key and child through the parent from a sibling with some to spare,
+    or else is merged with a sibling together with the separator between them.
+
+    Parameter - node: The internal node that is too small
+    Parameter - parent: Its parent
+    Parameter - index: The position of the node among the parent's children
+*/
+template <typename T>
+void BTree<T>::fixInternal(Internal* node, Internal* parent, int index) {
+    Internal* left = index > 0 ? static_cast<Internal*>(parent->children[index - 1]) : nullptr;
+    Internal* right = index < parent->count ? static_cast<Internal*>(parent->children[index + 1]) : nullptr;
+
+    if (left && left->count > INTERNAL_MINIMUM) {
+        // The separator comes down in front of node, the left sibling's last key goes up in its place
+        for (int i = node->count + 1; i > 0; i--) {
+            node->children[i] = node->children[i - 1];
+        }
+        node->children[0] = left->children[left->count];
+        insertAt(node->keys(), node->count, 0, std::move(parent->keys()[index - 1]));
+        node->count++;
+        parent->keys()[index - 1].~T();
+        new (&parent->keys()[index - 1]) T(std::move(left->keys()[left->count - 1]));
+        left->keys()[left->count - 1].~T();
+        left->count--;
+    }
+    else if (right && right->count > INTERNAL_MINIMUM) {
+        // The separator comes down at the end of node, the right sibling's first key goes up in its place
+        new (&node->keys()[node->count]) T(std::move(parent->keys()[index]));
+        node->children[node->count + 1] = right->children[0];
+        node->count++;
+        parent->keys()[index].~T();
+        new (&parent->keys()[index]) T(std::move(right->keys()[0]));
+        eraseAt(right->keys(), right->count, 0);
+        for (int i = 0; i < right->count; i++) {
+            right->children[i] = right->children[i + 1];
+        }
+        right->count--;
+    }
+    else {
+        // Merge the right one of the pair and the separator between them into the left one
+        Internal* into = left ? left : node;
+        Internal* from = left ? node : right;
+        int separator = left ? index - 1 : index;
+        new (&into->keys()[into->count]) T(std::move(parent->keys()[separator]));
+        moveRange(from->keys(), into->keys() + into->count + 1, from->count);
+        for (int i = 0; i <= from->count; i++) {
+            into->children[into->count + 1 + i] = from->children[i];
+        }
+        into->count += from->count + 1;
+        from->count = 0;
+        removeFromInternal(parent, separator);
+        internalPool.destroy(from);
+    }
+}
+
+/*
+    Removes the element equal to a key from the B-tree
+
+    This function walks down to the leaf holding the element, remembering the path, and removes it.
+    A leaf left with too few elements borrows from or merges with a sibling, and merges are repeated up
+    the path as far as needed. A root with a single child is replaced by that child.
+    Separators are left as they are when the element they were copied from is removed; they still
+    divide the elements correctly.
+
+    Parameter - key: The data (or a key comparable with it) of the element to be removed
+    Return - True if an element was removed, false if no element is equal to key
+*/
+template <typename T>
+template <typename Key>
+bool BTree<T>::remove(const Key& key) {
+    if (!root)
+        return false;
+
+    Internal* path[BTREE_MAX_HEIGHT];
+    int indexes[BTREE_MAX_HEIGHT];
+    int depth = 0;
+    Node* node = root;
+    while (!node->isLeaf) {
+        Internal* internal = static_cast<Internal*>(node);
+        int index = childIndex(internal, key);
+        path[depth] = internal;
+        indexes[depth] = index;
+        depth++;
+        node = internal->children[index];
+    }
+
+    Leaf* leaf = static_cast<Leaf*>(node);
+    int position = 0;
+    while (position < leaf->count && leaf->items()[position] < key)
+        position++;
+    if (position == leaf->count || key < leaf->items()[position])
+        return false;
+
+    eraseAt(leaf->items(), leaf->count, position);
+    leaf->count--;
+    count--;
+
+    if (depth == 0) {
+        if (leaf->count == 0) {
+            leafPool.destroy(leaf);
+            root = nullptr;
+        }
+        return true;
+    }
+    if (leaf->count >= LEAF_MINIMUM)
+        return true;
+
+    fixLeaf(leaf, path[depth - 1], indexes[depth - 1]);
+    for (int d = depth - 1; d >= 0; d--) {
+        Internal* internal = path[d];
+        if (d == 0) {
+            if (internal->count == 0) {
+                root = internal->children[0];
+                internalPool.destroy(internal);
+            }
+            break;
+        }
+        if (internal->count >= INTERNAL_MINIMUM)
+            break;
+        fixInternal(internal, path[d - 1], indexes[d - 1]);
+    }
+    return true;
+}
+
+/*
+    Finds the element equal to a key in the B-tree and returns a pointer to it.
+
+    Parameter - key: The data (or a key comparable with it) to search for
+    Return - A pointer to the data if found, otherwise nullptr (valid until the next insert or remove)
+*/
+template <typename T>
+template <typename Key>
+T* BTree<T>::find(const Key& key) const {
+    const Leaf* leaf = findLeaf(key);
+    if (!leaf)
+        return nullptr;
+
+    for (int i = 0; i < leaf->count; i++) {
+        const T& item = leaf->items()[i];
+        if (!(item < key))
+            return key < item ? nullptr : const_cast<T*>(&item);
+    }
+    return nullptr;
+}
+
+/*
+    Replaces the contents of the B-tree with the given items
+
+    This function fills full leaves from the items and then builds each level of internal nodes above them,
+    spreading the entries evenly over the nodes of each level. The items must be in ascending order with
+    no duplicates (the same order getAllItems returns).
+
+    Parameter - items: The sorted, duplicate-free items to store in the tree
+*/
+template <typename T>
+void BTree<T>::buildFromSorted(const vector<T>& items) {
+    clear();
+    int n = static_cast<int>(items.size());
+    if (n == 0)
+        return;
+
+    // Leaves, each with the first element under it (used for the separators above it)
+    vector<Node*> level;
+    vector<const T*> firsts;
+    int leafCount = (n + LEAF_CAPACITY - 1) / LEAF_CAPACITY;
+    Leaf* previous = nullptr;
+    int next = 0;
+    for (int l = 0; l < leafCount; l++) {
+        int size = n / leafCount + (l < n % leafCount ? 1 : 0);
+        Leaf* leaf = leafPool.create();
+        for (int i = 0; i < size; i++) {
+            new (&leaf->items()[i]) T(items[next + i]);
+        }
+        leaf->count = size;
+        leaf->prev = previous;
+        if (previous)
+            previous->next = leaf;
+        previous = leaf;
+        level.push_back(leaf);
+        firsts.push_back(&leaf->items()[0]);
+        next += size;
+    }
+
+    // Internal levels, until a single node is left
+    while (level.size() > 1) {
+        int m = static_cast<int>(level.size());
+        int nodeCount = (m + INTERNAL_CAPACITY) / (INTERNAL_CAPACITY + 1);
+        vector<Node*> parents;
+        vector<const T*> parentFirsts;
+        int child = 0;
+        for (int p = 0; p < nodeCount; p++) {
+            int size = m / nodeCount + (p < m % nodeCount ? 1 : 0);
+            Internal* internal = internalPool.create();
+            for (int i = 0; i < size; i++) {
+                internal->children[i] = level[child + i];
+                if (i > 0)
+                    new (&internal->keys()[i - 1]) T(*firsts[child + i]);
+            }
+            internal->count = size - 1;
+            parents.push_back(internal);
+            parentFirsts.push_back(firsts[child]);
+            child += size;
+        }
+        level.swap(parents);
+        firsts.swap(parentFirsts);
+    }
+
+    root = level[0];
+    count = n;
+}
+
+/*
+    Destroys every element and separator in a subtree
+
+    Parameter - node: The root of the subtree
+*/
+template <typename T>
+void BTree<T>::destroyContents(Node* node) {
+    if (node->isLeaf) {
+        Leaf* leaf = static_cast<Leaf*>(node);
+        for (int i = 0; i < leaf->count; i++) {
+            leaf->items()[i].~T();
+        }
+        return;
+    }
+    Internal* internal = static_cast<Internal*>(node);
+    for (int i = 0; i <= internal->count; i++) {
+        destroyContents(internal->children[i]);
+    }
+    for (int i = 0; i < internal->count; i++) {
+        internal->keys()[i].~T();
+    }
+}
+
+/*
+    Deletes all elements in the B-tree.
+
+    The nodes live in the tree's own pools, so they are freed by releasing the pools' chunks;
+    the nodes are only visited when the elements have destructors to run.
+*/
+template <typename T>
+void BTree<T>::clear() {
+    if (root && !is_trivially_destructible<T>::value)
+        destroyContents(root);
+    leafPool.releaseAll();
+    internalPool.releaseAll();
+    root = nullptr;
+    count = 0;
+}
+
+/*
+    Finds the smallest element that is not less than a key
+
+    Parameter - key: The value or key to compare against
+    Return - An iterator to the first element >= key, or end() if every element is smaller
+*/
+template <typename T>
+template <typename Key>
+typename BTree<T>::const_iterator BTree<T>::lowerBound(const Key& key) const {
+    const Leaf* leaf = findLeaf(key);
+    if (!leaf)
+        return end();
+
+    int i = 0;
+    while (i < leaf->count && leaf->items()[i] < key)
+        i++;
+    if (i == leaf->count)
+        return const_iterator(leaf->next, 0, this);
+    return const_iterator(leaf, i, this);
+}
+
+/*
+    Finds the smallest element that is greater than a key
+
+    Parameter - key: The value or key to compare against
+    Return - An iterator to the first element > key, or end() if no element is greater
+*/
+template <typename T>
+template <typename Key>
+typename BTree<T>::const_iterator BTree<T>::upperBound(const Key& key) const {
+    const Leaf* leaf = findLeaf(key);
+    if (!leaf)
+        return end();
+
+    int i = 0;
+    while (i < leaf->count && !(key < leaf->items()[i]))
+        i++;
+    if (i == leaf->count)
+        return const_iterator(leaf->next, 0, this);
+    return const_iterator(leaf, i, this);
+}
+
+/*
+    Gets the elements between two keys
+
+    Parameter - low: The smallest value (or key) to include
+    Parameter - high: The largest value (or key) to include
+    Return - A range of the elements >= low and <= high, in ascending order (empty if high < low)
+*/
+template <typename T>
+template <typename Key>
+typename BTree<T>::Range BTree<T>::range(const Key& low, const Key& high) const {
+    if (high < low)
+        return Range(end(), end());
+    return Range(lowerBound(low), upperBound(high));
+}
+
+/*
+    Visits the elements in ascending order from a starting value
+
+    Parameter - low: The smallest value (or key) to visit
+    Parameter - visit: A callable taking a const T& and returning true to continue or false to stop
+*/
+template <typename T>
+template <typename Key, typename Visitor>
+void BTree<T>::visitFrom(const Key& low, Visitor visit) const {
+    for (const_iterator it = lowerBound(low); it != end(); ++it) {
+        if (!visit(*it))
+            return;
+    }
+}
+
+/*
+    Returns all elements in the B-tree in sorted order.
+
+    This function walks the linked leaves from the first one and copies their elements.
+
+    Return - A vector containing all elements of the B-tree in sorted order
+*/
+template <typename T>
+vector<T> BTree<T>::getAllItems() const {
+    vector<T> items;
+    items.reserve(count);
+    for (const Leaf* leaf = firstLeaf(); leaf; leaf = leaf->next) {
+        for (int i = 0; i < leaf->count; i++) {
+            items.push_back(leaf->items()[i]);
+        }
+    }
+    return items;
+}
+
+/*
+    Displays all elements in the B-tree in sorted order.
+
+    Output - Prints each element of the B-tree to the standard output, one per line
+*/
+template <typename T>
+void BTree<T>::displayInOrder() const {
+    for (const_iterator it = begin(); it != end(); ++it) {
+        cout << *it << endl;
+    }
+}
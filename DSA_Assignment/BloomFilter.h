@@ -0,0 +1,156 @@
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "HashTable.h"
+
+using namespace std;
+
+// Number of bits in one block of the filter (one 64-byte cache line)
+const int BLOOM_FILTER_BLOCK_BITS = 512;
+
+/*
+    Counters describing how a Bloom filter in front of a table is doing
+
+    A query is rejected when the filter proves the key is absent, so the table is never touched.
+    A false positive is a query the filter let through for a key that turned out to be absent.
+*/
+struct BloomFilterStats {
+    long long queries;          // Lookups that consulted the filter
+    long long rejected;         // Lookups answered "absent" by the filter alone
+    long long falsePositives;   // Lookups the filter let through that still found nothing
+    int keys;                   // Keys added to the filter
+    int capacity;               // Keys the filter was sized for
+    int hashCount;              // Bits set per key
+    size_t memoryBytes;         // Size of the bit array
+
+    BloomFilterStats() : queries(0), rejected(0), falsePositives(0), keys(0), capacity(0), hashCount(0), memoryBytes(0) {}
+};
+
+/*
+    BloomFilter class implementation (blocked Bloom filter over precomputed hash values)
+
+    A Bloom filter answers "is this key possibly in the set?" with no false negatives and a small,
+    configurable rate of false positives, using only a few bits per key.
+    This is a blocked filter: all the bits of one key live in the same 64-byte block, so a query
+    reads a single cache line. It is built from the hash values the tables already compute, so no
+    key is hashed twice. Keys cannot be removed; the filter is rebuilt instead.
+*/
+class BloomFilter {
+private:
+    // One cache line of filter bits
+    struct alignas(64) Block {
+        unsigned long long words[BLOOM_FILTER_BLOCK_BITS / 64];
+    };
+
+    vector<Block> blocks;
+    int hashCount;      // Bits set per key
+    int keyCount;       // Keys added so far
+    int capacity;       // Keys the filter was sized for
+
+    // Splits a hash value into a block index and two values used to pick the bits inside the block
+    void locate(size_t hashValue, size_t& block, unsigned int& first, unsigned int& step) const {
+        unsigned long long mixed = hashKey(static_cast<unsigned long long>(hashValue));
+        block = static_cast<size_t>(((mixed >> 32) * blocks.size()) >> 32);
+        first = static_cast<unsigned int>(mixed);
+        step = static_cast<unsigned int>((mixed * 0x9e3779b97f4a7c15ULL) >> 32) | 1u;
+    }
+
+public:
+    BloomFilter() : hashCount(0), keyCount(0), capacity(0) {}
+
+    // Sizes an empty filter for a number of keys and a target false positive rate (0 < rate < 1)
+    void configure(int expectedKeys, double falsePositiveRate);
+
+    // Adds the key with the given hash value
+    void add(size_t hashValue);
+
+    // Returns false if the key with the given hash value is certainly not in the set
+    bool mayContain(size_t hashValue) const;
+
+    // Removes every key and releases the bit array
+    void clear();
+
+    bool isEnabled() const { return !blocks.empty(); }
+    int size() const { return keyCount; }
+    int getCapacity() const { return capacity; }
+    int getHashCount() const { return hashCount; }
+    size_t memoryBytes() const { return blocks.size() * sizeof(Block); }
+};
+
+
+/*
+    Sizes the filter for a number of keys
+
+    The number of bits per key and the number of bits set per key follow the usual Bloom filter formulas
+    (bits per key = -ln(rate) / ln(2)^2, bits set = bits per key * ln(2)). A blocked filter comes out a little
+    above the target rate, so a little more space is used than the formula gives.
+
+    Parameter - expectedKeys: The number of keys the filter should hold
+    Parameter - falsePositiveRate: The accepted share of absent keys that pass the filter (e.g. 0.01)
+    Return - None (the filter is emptied)
+*/
+inline void BloomFilter::configure(int expectedKeys, double falsePositiveRate) {
+    falsePositiveRate = min(max(falsePositiveRate, 1e-6), 0.5);
+    expectedKeys = max(expectedKeys, 1);
+
+    double ln2 = log(2.0);
+    double bitsPerKey = -log(falsePositiveRate) / (ln2 * ln2) * 1.1;
+    hashCount = min(max(static_cast<int>(bitsPerKey * ln2 + 0.5), 1), 16);
+
+    size_t blockCount = static_cast<size_t>(ceil(expectedKeys * bitsPerKey / BLOOM_FILTER_BLOCK_BITS));
+    blocks.assign(max(blockCount, static_cast<size_t>(1)), Block());
+    keyCount = 0;
+    capacity = expectedKeys;
+}
+
+/*
+    Adds a key to the filter
+
+    Parameter - hashValue: The full hash of the key (as computed by the table's hasher)
+    Return - None
+*/
+inline void BloomFilter::add(size_t hashValue) {
+    size_t block;
+    unsigned int position, step;
+    locate(hashValue, block, position, step);
+
+    Block& bits = blocks[block];
+    for (int i = 0; i < hashCount; i++) {
+        unsigned int bit = position >> 23;     // Top 9 bits select one of the 512 bits
+        bits.words[bit >> 6] |= 1ULL << (bit & 63);
+        position += step;
+    }
+    keyCount++;
+}
+
+/*
+    Checks whether a key may be in the filter
+
+    Parameter - hashValue: The full hash of the key (as computed by the table's hasher)
+    Return - False if the key was never added, true if it may have been
+*/
+inline bool BloomFilter::mayContain(size_t hashValue) const {
+    size_t block;
+    unsigned int position, step;
+    locate(hashValue, block, position, step);
+
+    const Block& bits = blocks[block];
+    for (int i = 0; i < hashCount; i++) {
+        unsigned int bit = position >> 23;
+        if (!(bits.words[bit >> 6] & (1ULL << (bit & 63))))
+            return false;
+        position += step;
+    }
+    return true;
+}
+
+// Removes every key and releases the bit array (the filter is disabled until configured again)
+inline void BloomFilter::clear() {
+    vector<Block>().swap(blocks);
+    hashCount = 0;
+    keyCount = 0;
+    capacity = 0;
+}
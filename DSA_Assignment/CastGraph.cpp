@@ -0,0 +1,312 @@
+#include <algorithm>
+
+#include "CastGraph.h"
+
+using namespace std;
+
+/*
+    Looks up the position of a vertex in one partition
+
+    Parameter - positions: The partition's table of positions
+    Parameter - id: The ID of the vertex
+    Return - The position of the vertex, or -1 if it is not in the graph
+*/
+int CastGraph::positionOf(const HashTable<RecordId, int>& positions, RecordId id) {
+    const int* position = positions.find(id);
+    return position ? *position : -1;
+}
+
+/*
+    Adds an actor to the graph with no edges
+
+    Parameter - actorId: The ID of the actor
+    Return - True if the actor was added, false if it was already in the graph
+*/
+bool CastGraph::addActor(RecordId actorId) {
+    if (!actorPositions.insert(actorId, static_cast<int>(actorIds.size())))
+        return false;
+    expand();
+    actorIds.push_back(actorId);
+    moviesOfActor.push_back(vector<int>());
+    return true;
+}
+
+/*
+    Adds a movie to the graph with no edges
+
+    Parameter - movieId: The ID of the movie
+    Return - True if the movie was added, false if it was already in the graph
+*/
+bool CastGraph::addMovie(RecordId movieId) {
+    if (!moviePositions.insert(movieId, static_cast<int>(movieIds.size())))
+        return false;
+    expand();
+    movieIds.push_back(movieId);
+    actorsOfMovie.push_back(vector<int>());
+    return true;
+}
+
+/*
+    Adds an edge between an actor and a movie - used for Cast Relationships
+
+    This function adds the actor and the movie first if they are not in the graph yet.
+
+    Parameter - actorId: The ID of the actor
+    Parameter - movieId: The ID of the movie
+    Return - True if the edge was added, false if the actor was already cast in the movie
+*/
+bool CastGraph::addEdge(RecordId actorId, RecordId movieId) {
+    addActor(actorId);
+    addMovie(movieId);
+    if (hasEdge(actorId, movieId))
+        return false;
+
+    expand();
+    int actorPosition = positionOf(actorPositions, actorId);
+    int moviePosition = positionOf(moviePositions, movieId);
+    moviesOfActor[actorPosition].push_back(moviePosition);
+    actorsOfMovie[moviePosition].push_back(actorPosition);
+    edgeCount++;
+    return true;
+}
+
+/*
+    Checks if an actor is cast in a movie
+
+    This function scans the shorter of the two adjacency lists.
+
+    Parameter - actorId: The ID of the actor
+    Parameter - movieId: The ID of the movie
+    Return - True if the edge exists, otherwise false
+*/
+bool CastGraph::hasEdge(RecordId actorId, RecordId movieId) const {
+    int actorPosition = positionOf(actorPositions, actorId);
+    int moviePosition = positionOf(moviePositions, movieId);
+    if (actorPosition == -1 || moviePosition == -1)
+        return false;
+
+    const int* firstMovie;
+    const int* lastMovie;
+    const int* firstActor;
+    const int* lastActor;
+    movieRange(actorPosition, firstMovie, lastMovie);
+    actorRange(moviePosition, firstActor, lastActor);
+    if (lastMovie - firstMovie <= lastActor - firstActor)
+        return find(firstMovie, lastMovie, moviePosition) != lastMovie;
+    return find(firstActor, lastActor, actorPosition) != lastActor;
+}
+
+/*
+    Removes a vertex from one partition
+
+    The vertex is removed from the adjacency lists of its neighbours in the other partition, then the last vertex
+    of its partition is moved into its position, and that vertex's neighbours are updated to the new position.
+
+    Parameter - positions: The partition's table of positions
+    Parameter - ids: The partition's IDs
+    Parameter - adjacency: The partition's adjacency lists
+    Parameter - otherAdjacency: The other partition's adjacency lists
+    Parameter - position: The position of the vertex to remove
+    Return - None
+*/
+void CastGraph::removeVertex(HashTable<RecordId, int>& positions, vector<RecordId>& ids,
+    vector<vector<int>>& adjacency, vector<vector<int>>& otherAdjacency, int position) {
+    for (int neighbor : adjacency[position]) {
+        vector<int>& list = otherAdjacency[neighbor];
+        for (size_t i = 0; i < list.size(); i++) {
+            if (list[i] == position) {
+                list.erase(list.begin() + i);
+                break;
+            }
+        }
+    }
+
+    positions.erase(ids[position]);
+    int last = static_cast<int>(ids.size()) - 1;
+    if (position != last) {
+        for (int neighbor : adjacency[last]) {
+            for (int& entry : otherAdjacency[neighbor]) {
+                if (entry == last) {
+                    entry = position;
+                    break;
+                }
+            }
+        }
+        ids[position] = ids[last];
+        adjacency[position].swap(adjacency[last]);
+        *positions.find(ids[position]) = position;
+    }
+    ids.pop_back();
+    adjacency.pop_back();
+}
+
+/*
+    Removes an actor and all of their edges from the graph
+
+    Parameter - actorId: The ID of the actor
+    Return - True if the actor was removed, false if they were not in the graph
+*/
+bool CastGraph::removeActor(RecordId actorId) {
+    int position = positionOf(actorPositions, actorId);
+    if (position == -1)
+        return false;
+    expand();
+    edgeCount -= static_cast<int>(moviesOfActor[position].size());
+    removeVertex(actorPositions, actorIds, moviesOfActor, actorsOfMovie, position);
+    return true;
+}
+
+/*
+    Removes a movie and all of its edges from the graph
+
+    Parameter - movieId: The ID of the movie
+    Return - True if the movie was removed, false if it was not in the graph
+*/
+bool CastGraph::removeMovie(RecordId movieId) {
+    int position = positionOf(moviePositions, movieId);
+    if (position == -1)
+        return false;
+    expand();
+    edgeCount -= static_cast<int>(actorsOfMovie[position].size());
+    removeVertex(moviePositions, movieIds, actorsOfMovie, moviesOfActor, position);
+    return true;
+}
+
+/*
+    Retrieves the IDs of the movies an actor is cast in
+
+    Parameter - actorId: The ID of the actor
+    Return - The movie IDs in the order the edges were added (empty if the actor is not in the graph)
+*/
+vector<RecordId> CastGraph::getMovies(RecordId actorId) const {
+    vector<RecordId> movies;
+    forEachMovieOf(actorId, [&](RecordId movieId) { movies.push_back(movieId); });
+    return movies;
+}
+
+/*
+    Retrieves the IDs of the actors cast in a movie
+
+    Parameter - movieId: The ID of the movie
+    Return - The actor IDs in the order the edges were added (empty if the movie is not in the graph)
+*/
+vector<RecordId> CastGraph::getActors(RecordId movieId) const {
+    vector<RecordId> actors;
+    forEachActorOf(movieId, [&](RecordId actorId) { actors.push_back(actorId); });
+    return actors;
+}
+
+/*
+    Packs the adjacency lists of one partition into offsets and a flat array of neighbours
+
+    Parameter - lists: The adjacency lists (emptied and freed)
+    Parameter - offsets: Receives one offset per vertex plus one; vertex i's neighbours are at [offsets[i], offsets[i + 1])
+    Parameter - neighbors: Receives every vertex's neighbours, one vertex after another
+    Return - None
+*/
+void CastGraph::packLists(vector<vector<int>>& lists, vector<int>& offsets, vector<int>& neighbors) {
+    size_t total = 0;
+    for (const vector<int>& list : lists) {
+        total += list.size();
+    }
+
+    offsets.assign(lists.size() + 1, 0);
+    neighbors.clear();
+    neighbors.reserve(total);
+    for (size_t i = 0; i < lists.size(); i++) {
+        neighbors.insert(neighbors.end(), lists[i].begin(), lists[i].end());
+        offsets[i + 1] = static_cast<int>(neighbors.size());
+    }
+    vector<vector<int>>().swap(lists);
+}
+
+/*
+    Turns the offsets and flat array of one partition back into adjacency lists
+
+    Parameter - lists: Receives one adjacency list per vertex
+    Parameter - offsets: The offsets (emptied and freed)
+    Parameter - neighbors: The flat array of neighbours (emptied and freed)
+    Return - None
+*/
+void CastGraph::unpackLists(vector<vector<int>>& lists, vector<int>& offsets, vector<int>& neighbors) {
+    size_t vertexCount = offsets.empty() ? 0 : offsets.size() - 1;
+    lists.assign(vertexCount, vector<int>());
+    for (size_t i = 0; i < vertexCount; i++) {
+        lists[i].assign(neighbors.begin() + offsets[i], neighbors.begin() + offsets[i + 1]);
+    }
+    vector<int>().swap(offsets);
+    vector<int>().swap(neighbors);
+}
+
+/*
+    Packs the adjacency lists into the compacted (CSR) form
+
+    This function is meant to be called once the cast relationships are loaded. Lookups and listings keep
+    working on the compacted form; the next change to the graph calls expand first.
+
+    Return - None
+*/
+void CastGraph::compact() {
+    if (compacted)
+        return;
+    packLists(moviesOfActor, movieOffsets, movieNeighbors);
+    packLists(actorsOfMovie, actorOffsets, actorNeighbors);
+    compacted = true;
+}
+
+/*
+    Moves the edges from the compacted form back into adjacency lists
+
+    This function does nothing if the graph is not compacted.
+
+    Return - None
+*/
+void CastGraph::expand() {
+    if (!compacted)
+        return;
+    unpackLists(moviesOfActor, movieOffsets, movieNeighbors);
+    unpackLists(actorsOfMovie, actorOffsets, actorNeighbors);
+    compacted = false;
+}
+
+/*
+    Retrieves the positions of an actor's movies
+
+    This function reads from the compacted form if the graph is compacted, otherwise from the actor's adjacency list.
+
+    Parameter - actorPosition: The position of the actor
+    Parameter - first: Receives a pointer to the first movie position
+    Parameter - last: Receives a pointer past the last movie position
+    Return - None
+*/
+void CastGraph::movieRange(int actorPosition, const int*& first, const int*& last) const {
+    if (compacted) {
+        first = movieNeighbors.data() + movieOffsets[actorPosition];
+        last = movieNeighbors.data() + movieOffsets[actorPosition + 1];
+    }
+    else {
+        first = moviesOfActor[actorPosition].data();
+        last = first + moviesOfActor[actorPosition].size();
+    }
+}
+
+/*
+    Retrieves the positions of a movie's actors
+
+    This function reads from the compacted form if the graph is compacted, otherwise from the movie's adjacency list.
+
+    Parameter - moviePosition: The position of the movie
+    Parameter - first: Receives a pointer to the first actor position
+    Parameter - last: Receives a pointer past the last actor position
+    Return - None
+*/
+void CastGraph::actorRange(int moviePosition, const int*& first, const int*& last) const {
+    if (compacted) {
+        first = actorNeighbors.data() + actorOffsets[moviePosition];
+        last = actorNeighbors.data() + actorOffsets[moviePosition + 1];
+    }
+    else {
+        first = actorsOfMovie[moviePosition].data();
+        last = first + actorsOfMovie[moviePosition].size();
+    }
+}
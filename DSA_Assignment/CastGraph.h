@@ -0,0 +1,144 @@
+#pragma once
+#include <vector>
+
+#include "RecordId.h"
+#include "HashTable.h"
+
+using namespace std;
+
+/*
+    CastGraph class implementation (bipartite actor-movie graph keyed by record ID)
+
+    Actors and movies are kept in two separate partitions, and every edge joins an actor to a movie.
+    Vertices are identified by their Actor ID and Movie ID only, so an actor and a movie with the same name,
+    or two movies with the same title, are always separate vertices. Names stay in the Actor and Movie
+    records, so renaming a record does not touch the graph.
+
+    Each partition keeps a hash table from ID to a position, and an adjacency list of positions in the
+    other partition for every vertex. Finding a vertex is O(1) on average, listing a vertex's neighbours is
+    O(degree), and memory is O(V + E). Removing a vertex moves the last vertex of its partition into its place,
+    so it costs O(degree) of the two vertices involved.
+
+    Once the cast relationships are loaded, compact packs the adjacency lists of each partition into a CSR
+    (compressed sparse row) form: one array of offsets and one flat array holding every vertex's neighbours
+    one after another. That replaces one heap block per vertex with two blocks per partition, and listing
+    neighbours reads contiguous memory. The next change to the graph turns it back into adjacency lists
+    (O(V + E)), so compact should be called again after a batch of changes.
+*/
+class CastGraph {
+private:
+    HashTable<RecordId, int> actorPositions;    // Actor ID -> position in actorIds and moviesOfActor
+    HashTable<RecordId, int> moviePositions;    // Movie ID -> position in movieIds and actorsOfMovie
+    vector<RecordId> actorIds;
+    vector<RecordId> movieIds;
+    vector<vector<int>> moviesOfActor;          // Positions of each actor's movies (while not compacted)
+    vector<vector<int>> actorsOfMovie;          // Positions of each movie's actors (while not compacted)
+    vector<int> movieOffsets;                   // Compacted form: actor i's movies start at movieNeighbors[movieOffsets[i]]
+    vector<int> movieNeighbors;                 // Compacted form: every actor's movie positions, one actor after another
+    vector<int> actorOffsets;                   // Compacted form: movie i's actors start at actorNeighbors[actorOffsets[i]]
+    vector<int> actorNeighbors;                 // Compacted form: every movie's actor positions, one movie after another
+    bool compacted;                             // True while the edges are kept in the compacted form
+    int edgeCount;
+
+    // Returns the position of a vertex, or -1 if it is not in the graph
+    static int positionOf(const HashTable<RecordId, int>& positions, RecordId id);
+
+    // Removes the vertex at a position from one partition (the shared helper of removeActor and removeMovie)
+    static void removeVertex(HashTable<RecordId, int>& positions, vector<RecordId>& ids,
+        vector<vector<int>>& adjacency, vector<vector<int>>& otherAdjacency, int position);
+
+    // Packs one partition's adjacency lists into offsets and a flat array, and the reverse
+    static void packLists(vector<vector<int>>& lists, vector<int>& offsets, vector<int>& neighbors);
+    static void unpackLists(vector<vector<int>>& lists, vector<int>& offsets, vector<int>& neighbors);
+
+    // Moves the edges from the compacted form back into adjacency lists before the graph is changed
+    void expand();
+
+    // Get the neighbour positions of an actor's movies or a movie's actors, as a [first, last) range
+    void movieRange(int actorPosition, const int*& first, const int*& last) const;
+    void actorRange(int moviePosition, const int*& first, const int*& last) const;
+
+public:
+    CastGraph() : compacted(false), edgeCount(0) {}
+
+    // Add a vertex, returns false if it is already in the graph
+    bool addActor(RecordId actorId);
+    bool addMovie(RecordId movieId);
+
+    // Check if a vertex is in the graph
+    bool hasActor(RecordId actorId) const { return positionOf(actorPositions, actorId) != -1; }
+    bool hasMovie(RecordId movieId) const { return positionOf(moviePositions, movieId) != -1; }
+
+    // Add an edge between an actor and a movie (adding either vertex if needed), returns false if it already exists
+    bool addEdge(RecordId actorId, RecordId movieId);
+
+    // Check if an actor is cast in a movie
+    bool hasEdge(RecordId actorId, RecordId movieId) const;
+
+    // Remove a vertex and its edges, returns false if it is not in the graph
+    bool removeActor(RecordId actorId);
+    bool removeMovie(RecordId movieId);
+
+    // Calls visit(movieId) for every movie of an actor, in the order the edges were added
+    template <typename Visitor>
+    void forEachMovieOf(RecordId actorId, Visitor visit) const;
+
+    // Calls visit(actorId) for every actor of a movie, in the order the edges were added
+    template <typename Visitor>
+    void forEachActorOf(RecordId movieId, Visitor visit) const;
+
+    // Get the IDs of an actor's movies or a movie's actors
+    vector<RecordId> getMovies(RecordId actorId) const;
+    vector<RecordId> getActors(RecordId movieId) const;
+
+    // Pack the adjacency lists into the compacted (CSR) form
+    void compact();
+
+    // Check if the edges are in the compacted form
+    bool isCompacted() const { return compacted; }
+
+    int getActorCount() const { return static_cast<int>(actorIds.size()); }
+    int getMovieCount() const { return static_cast<int>(movieIds.size()); }
+    int getEdgeCount() const { return edgeCount; }
+};
+
+
+/*
+    Visits the movies an actor is cast in
+
+    Parameter - actorId: The ID of the actor
+    Parameter - visit: A callable taking a RecordId (nothing is visited if the actor is not in the graph)
+    Return - None
+*/
+template <typename Visitor>
+void CastGraph::forEachMovieOf(RecordId actorId, Visitor visit) const {
+    int position = positionOf(actorPositions, actorId);
+    if (position == -1)
+        return;
+    const int* first;
+    const int* last;
+    movieRange(position, first, last);
+    for (; first != last; ++first) {
+        visit(movieIds[*first]);
+    }
+}
+
+/*
+    Visits the actors cast in a movie
+
+    Parameter - movieId: The ID of the movie
+    Parameter - visit: A callable taking a RecordId (nothing is visited if the movie is not in the graph)
+    Return - None
+*/
+template <typename Visitor>
+void CastGraph::forEachActorOf(RecordId movieId, Visitor visit) const {
+    int position = positionOf(moviePositions, movieId);
+    if (position == -1)
+        return;
+    const int* first;
+    const int* last;
+    actorRange(position, first, last);
+    for (; first != last; ++first) {
+        visit(actorIds[*first]);
+    }
+}
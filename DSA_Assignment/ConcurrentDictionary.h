@@ -0,0 +1,240 @@
+#pragma once
+
+#include <vector>
+#include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <utility>
+#include <iostream>
+
+#include "HashTable.h"
+#include "RecordArena.h"
+
+using namespace std;
+
+// Number of independently locked stripes (must be a power of two, at most 256)
+#ifndef CONCURRENT_DICTIONARY_STRIPES
+#define CONCURRENT_DICTIONARY_STRIPES 16
+#endif
+
+static_assert((CONCURRENT_DICTIONARY_STRIPES & (CONCURRENT_DICTIONARY_STRIPES - 1)) == 0 && CONCURRENT_DICTIONARY_STRIPES <= 256,
+    "CONCURRENT_DICTIONARY_STRIPES must be a power of two, at most 256");
+
+/*
+    ConcurrentDictionary class implementation (thread-safe Dictionary using lock striping)
+
+    This class offers the same basic operations as Dictionary, but can be used from several threads at once.
+    The keys are split over CONCURRENT_DICTIONARY_STRIPES separate hash tables by the top byte of their hash,
+    and each table has its own reader/writer lock. Lookups only take a shared lock on one stripe, so any
+    number of threads can read at the same time, and a writer only blocks readers of its own stripe.
+
+    Records created by emplace are owned by the dictionary and are never freed before the dictionary is
+    destroyed, even when their key is removed. A pointer returned by get therefore stays valid while other
+    threads remove keys, so no reclamation scheme is needed for readers. Changing the fields of a shared
+    record must go through update, which holds the stripe's lock while the change is made.
+*/
+template <typename KeyType, typename ValueType, typename Hasher = DefaultHasher<KeyType>>
+class ConcurrentDictionary {
+public:
+    typedef typename LookupKey<KeyType>::Type KeyView;
+
+private:
+    // One hash table with its lock, padded to its own cache lines so stripes do not share a line
+    struct alignas(64) Stripe {
+        mutable shared_mutex lock;
+        HashTable<KeyType, ValueType*, Hasher> table;
+    };
+
+    Stripe stripes[CONCURRENT_DICTIONARY_STRIPES];
+    atomic<int> count;
+
+    mutex recordsLock;                  // Guards records (only taken when a record is created)
+    RecordArena<ValueType> records;     // Storage for the records created by emplace
+    Hasher hasher;
+
+    // Returns the stripe that holds the key
+    Stripe& stripeFor(KeyView key);
+    const Stripe& stripeFor(KeyView key) const;
+
+public:
+    ConcurrentDictionary() : count(0) {}
+
+    // The dictionary owns its records and locks, so it cannot be copied
+    ConcurrentDictionary(const ConcurrentDictionary&) = delete;
+    ConcurrentDictionary& operator=(const ConcurrentDictionary&) = delete;
+
+    // Basic operations
+    bool add(const KeyType& key, ValueType* value);    // The caller keeps ownership of value
+    bool remove(KeyView key);
+    ValueType* get(KeyView key) const;
+    bool isEmpty() const { return count.load() == 0; }
+    int getSize() const { return count.load(); }
+
+    // Constructs a record owned by the dictionary, returns nullptr if the key already exists
+    template <typename... Args>
+    ValueType* emplace(const KeyType& key, Args&&... args);
+
+    // Calls change(value) while holding the key's stripe lock, returns false if the key does not exist
+    template <typename Change>
+    bool update(KeyView key, Change change);
+
+    // Calls visit(value) for every value, one stripe at a time under its shared lock
+    template <typename Visitor>
+    void forEach(Visitor visit) const;
+};
+
+
+/*
+    Finds the stripe responsible for a key
+
+    The stripe is chosen by the top byte of the hash. The tables inside the stripes use the low bits,
+    so the keys of one stripe are still spread evenly over its table.
+
+    Parameter - key: The key to look up
+    Return - The stripe holding the key
+*/
+template <typename KeyType, typename ValueType, typename Hasher>
+typename ConcurrentDictionary<KeyType, ValueType, Hasher>::Stripe&
+ConcurrentDictionary<KeyType, ValueType, Hasher>::stripeFor(KeyView key) {
+    const ConcurrentDictionary& self = *this;
+    return const_cast<Stripe&>(self.stripeFor(key));
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+const typename ConcurrentDictionary<KeyType, ValueType, Hasher>::Stripe&
+ConcurrentDictionary<KeyType, ValueType, Hasher>::stripeFor(KeyView key) const {
+    size_t hashValue = hasher(key);
+    size_t index = (hashValue >> (sizeof(size_t) * 8 - 8)) & (CONCURRENT_DICTIONARY_STRIPES - 1);
+    return stripes[index];
+}
+
+/*
+    Inserts a new key-value pair into the dictionary
+
+    Parameter - key: The key to be inserted
+    Parameter - value: A pointer to the value associated with the key (not owned by the dictionary)
+    Return - True if insertion is successful, false if the key already exists
+*/
+template <typename KeyType, typename ValueType, typename Hasher>
+bool ConcurrentDictionary<KeyType, ValueType, Hasher>::add(const KeyType& key, ValueType* value) {
+    if (!value) {
+        cerr << "Error: Trying to add a null value for key: " << key << endl;
+        return false;
+    }
+
+    Stripe& stripe = stripeFor(key);
+    unique_lock<shared_mutex> guard(stripe.lock);
+    if (!stripe.table.insert(key, value)) {
+        cerr << "Error: Duplicate key detected: " << key << endl;
+        return false;
+    }
+    count++;
+    return true;
+}
+
+/*
+    Constructs a new record in the dictionary
+
+    This function holds the key's stripe lock from the duplicate check until the record is in the table,
+    so two threads adding the same key cannot both succeed.
+
+    Parameter - key: The key to be inserted
+    Parameter - args: The arguments passed to the record's constructor
+    Return - A pointer to the new record if successful, nullptr if the key already exists
+*/
+template <typename KeyType, typename ValueType, typename Hasher>
+template <typename... Args>
+ValueType* ConcurrentDictionary<KeyType, ValueType, Hasher>::emplace(const KeyType& key, Args&&... args) {
+    Stripe& stripe = stripeFor(key);
+    unique_lock<shared_mutex> guard(stripe.lock);
+    if (stripe.table.find(key)) {
+        cerr << "Error: Duplicate key detected: " << key << endl;
+        return nullptr;
+    }
+
+    ValueType* value;
+    {
+        lock_guard<mutex> recordsGuard(recordsLock);
+        value = records.create(std::forward<Args>(args)...);
+    }
+    stripe.table.insert(key, value);
+    count++;
+    return value;
+}
+
+/*
+    Removes a key from the dictionary
+
+    The record itself is not freed, so other threads that already hold a pointer to it can keep using it.
+
+    Parameter - key: The key to be removed
+    Return - True if the key was removed, false if the key was not found
+*/
+template <typename KeyType, typename ValueType, typename Hasher>
+bool ConcurrentDictionary<KeyType, ValueType, Hasher>::remove(KeyView key) {
+    Stripe& stripe = stripeFor(key);
+    unique_lock<shared_mutex> guard(stripe.lock);
+    if (!stripe.table.erase(key))
+        return false;
+    count--;
+    return true;
+}
+
+/*
+    Retrieves the value associated with a given key
+
+    This function only takes a shared lock on the key's stripe, so it runs in parallel with other lookups.
+
+    Parameter - key: The key whose value is to be retrieved
+    Return - A pointer to the associated value if found, otherwise nullptr
+*/
+template <typename KeyType, typename ValueType, typename Hasher>
+ValueType* ConcurrentDictionary<KeyType, ValueType, Hasher>::get(KeyView key) const {
+    const Stripe& stripe = stripeFor(key);
+    shared_lock<shared_mutex> guard(stripe.lock);
+    ValueType* const* found = stripe.table.find(key);
+    return found ? *found : nullptr;
+}
+
+/*
+    Changes a record while holding its stripe lock
+
+    This function is used for changes to a record that other threads may be reading, e.g. adding a rating.
+    Readers that go through get and then read fields are not blocked by it, so fields that must be read
+    consistently should also be read through update.
+
+    Parameter - key: The key of the record to change
+    Parameter - change: A callable taking a ValueType*
+    Return - True if the key was found and the change was made, false otherwise
+*/
+template <typename KeyType, typename ValueType, typename Hasher>
+template <typename Change>
+bool ConcurrentDictionary<KeyType, ValueType, Hasher>::update(KeyView key, Change change) {
+    Stripe& stripe = stripeFor(key);
+    unique_lock<shared_mutex> guard(stripe.lock);
+    ValueType** found = stripe.table.find(key);
+    if (!found)
+        return false;
+    change(*found);
+    return true;
+}
+
+/*
+    Visits every value stored in the dictionary
+
+    Each stripe is locked for reading while it is visited, so the visit does not see a single snapshot
+    of the whole dictionary when other threads are writing at the same time.
+
+    Parameter - visit: A callable taking a ValueType*
+    Return - None
+*/
+template <typename KeyType, typename ValueType, typename Hasher>
+template <typename Visitor>
+void ConcurrentDictionary<KeyType, ValueType, Hasher>::forEach(Visitor visit) const {
+    for (const Stripe& stripe : stripes) {
+        shared_lock<shared_mutex> guard(stripe.lock);
+        stripe.table.forEach([&visit](const typename HashTable<KeyType, ValueType*, Hasher>::Entry& entry) {
+            visit(entry.value);
+        });
+    }
+}
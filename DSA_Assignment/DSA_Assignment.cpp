@@ -5,8 +5,10 @@
 
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <fstream>
 #include <sstream>
+#include <iomanip>       // For setprecision
 #include <ctime>         // For getting the current year dynamically
 #include <limits>        // For numeric_limits
 #include <sys/stat.h>    // For fileExists
@@ -16,7 +18,9 @@
 #include "Movie.h"
 #include "Dictionary.h"
 #include "AVLTree.h"
-#include "Graph.h"
+#include "CastGraph.h"
+#include "NameIndex.h"
+#include "RangeIndex.h"
 
 using namespace std;
 
@@ -28,13 +32,30 @@ vector<Actor*> newActors;
 vector<Movie*> newMovies;              
 
 // Stores new cast relationships (ActorID, MovieID)
-vector<pair<string, string>> newCasts; 
+vector<pair<RecordId, RecordId>> newCasts; 
 
-Dictionary<string, Actor> actorDictionary;
-Dictionary<string, Movie> movieDictionary; 
+// Actors and movies keyed by their numeric IDs
+Dictionary<RecordId, Actor> actorDictionary;
+Dictionary<RecordId, Movie> movieDictionary; 
 
-// Graph to represent actor-movie relationships
-Graph<string> actorMovieGraph;              
+// Secondary index from actor name to actors, kept in sync with actorDictionary
+NameIndex<Actor> actorNameIndex;
+
+// Secondary index from movie title to movies, kept in sync with movieDictionary
+NameIndex<Movie> movieTitleIndex;
+
+// Secondary index from birth year to actors, kept in sync with actorDictionary (also summarizes ratings per year range)
+RangeIndex<Actor, int, RatingAggregate<Actor>> actorBirthYearIndex;
+
+// Secondary index from release year to movies, kept in sync with movieDictionary (also summarizes ratings per year range)
+RangeIndex<Movie, int, RatingAggregate<Movie>> movieYearIndex;
+
+// Secondary indexes from average rating to actors and movies, kept in sync when a rating is added
+RangeIndex<Actor, double> actorRatingIndex;
+RangeIndex<Movie, double> movieRatingIndex;
+
+// Bipartite graph of actor-movie relationships, keyed by Actor ID and Movie ID
+CastGraph actorMovieGraph;
 
 // ==================== Menu Functions ====================
 
@@ -59,7 +80,9 @@ void adminMenu() {
     cout << "(2) Add new movie" << endl;
     cout << "(3) Add an actor to a movie" << endl;
     cout << "(4) Update actor/movie details" << endl;
-    cout << "(5) Go back to Main Menu" << endl;
+    cout << "(5) Show hash table statistics" << endl;
+    cout << "(6) List actors/movies by ID range" << endl;
+    cout << "(7) Go back to Main Menu" << endl;
     cout << "-------------------------------------" << endl;
     cout << "Enter your choice: ";
 }
@@ -76,7 +99,8 @@ void userMenu() {
     cout << "(5) Display a list of all actors that a particular actor knows" << endl;
     cout << "(6) Rate a Movie or Actor" << endl;
     cout << "(7) Display Top 10 rating for Actor or Movie" << endl;
-    cout << "(8) Go back to Main Menu" << endl;
+    cout << "(8) Display the best rated Actor or Movie within a range of years" << endl;
+    cout << "(9) Go back to Main Menu" << endl;
     cout << "=====================================" << endl;
     cout << "Enter your choice: ";
 }
@@ -139,6 +163,52 @@ string getNonEmptyInput(const string& prompt) {
 }
 
 
+/*
+    Validator to check if user input is a valid actor or movie ID
+
+	This function repeatly prompts the user for an input till it is a valid numeric ID.
+
+    Parameter - prompt: The message displayed to prompt the user for input
+    Return - The ID entered by the user
+*/
+RecordId getIdInput(const string& prompt) {
+    while (true) {
+        string input = getNonEmptyInput(prompt);
+        RecordId id;
+        if (parseRecordId(input, id)) {
+            return id;
+        }
+        cout << "[Error] Invalid ID. Please enter a number.\n";
+    }
+}
+
+
+/*
+    Validator to check if user input is a valid year
+
+	This function repeatly prompts the user for an input till it is a positive integer.
+
+    Parameter - prompt: The message displayed to prompt the user for input
+    Return - The year entered by the user
+*/
+int getYearInput(const string& prompt) {
+    while (true) {
+        cout << prompt;
+        int year;
+        cin >> year;
+        if (cin.fail() || year <= 0) {
+            cout << "[Error] Invalid year. Please enter a positive integer.\n";
+            cin.clear();
+            cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        }
+        else {
+            cin.ignore(numeric_limits<streamsize>::max(), '\n');
+            return year;
+        }
+    }
+}
+
+
 /*
     Parses a CSV line into individual fields
 
@@ -238,6 +308,89 @@ bool isAllDigits(const string& s) {
 }
 
 
+/*
+    Finds an actor by name using the actor name index
+
+    This function looks the name up in actorNameIndex (ignoring case and extra spaces).
+    If several actors share the name, it lists them and prompts for the Actor ID of the one wanted.
+
+    Parameter - name: The actor name to search for
+    Return - A pointer to the matching actor, or nullptr if no actor has the name
+*/
+Actor* findActorByName(const string& name) {
+    const vector<Actor*>* matches = actorNameIndex.find(name);
+    if (!matches)
+        return nullptr;
+    if (matches->size() == 1)
+        return matches->front();
+
+    cout << "[Info] More than one actor is named \"" << name << "\":\n";
+    for (const Actor* actor : *matches) {
+        cout << " - ID: " << actor->id << ", Birth Year: " << actor->birthYear << "\n";
+    }
+    while (true) {
+        RecordId id = getIdInput("Enter the Actor ID: ");
+        for (Actor* actor : *matches) {
+            if (actor->id == id)
+                return actor;
+        }
+        cout << "[Error] Actor ID is not one of the listed actors.\n";
+    }
+}
+
+/*
+    Finds a movie by title using the movie title index
+
+    This function looks the title up in movieTitleIndex, which ignores surrounding quotes, case and extra spaces.
+    If several movies share the title, it lists them and prompts for the Movie ID of the one wanted.
+
+    Parameter - title: The movie title to search for
+    Return - A pointer to the matching movie, or nullptr if no movie has the title
+*/
+Movie* findMovieByTitle(const string& title) {
+    const vector<Movie*>* matches = movieTitleIndex.find(title);
+    if (!matches)
+        return nullptr;
+    if (matches->size() == 1)
+        return matches->front();
+
+    cout << "[Info] More than one movie is titled \"" << title << "\":\n";
+    for (const Movie* movie : *matches) {
+        cout << " - ID: " << movie->id << ", Year: " << movie->year << "\n";
+    }
+    while (true) {
+        RecordId id = getIdInput("Enter the Movie ID: ");
+        for (Movie* movie : *matches) {
+            if (movie->id == id)
+                return movie;
+        }
+        cout << "[Error] Movie ID is not one of the listed movies.\n";
+    }
+}
+
+/*
+    Builds the secondary indexes from the loaded dictionaries
+
+    This function is called once after the CSV files are loaded. Afterwards the indexes are
+    updated by the functions that add or rename actors and movies.
+
+    Parameter - None
+    Return - None (fills the name, title, year and rating indexes)
+*/
+void buildIndexes() {
+    actorDictionary.forEach([](Actor* actor) {
+        actorNameIndex.add(actor->name, actor);
+        actorBirthYearIndex.add(actor->birthYear, actor);
+        actorRatingIndex.add(actor->rating, actor);
+    });
+    movieDictionary.forEach([](Movie* movie) {
+        movieTitleIndex.add(movie->title, movie);
+        movieYearIndex.add(movie->getYearAsInt(), movie);
+        movieRatingIndex.add(movie->rating, movie);
+    });
+}
+
+
 // ==================== Sorting Functions ====================
 
 /*
@@ -290,154 +443,6 @@ void quickSort(vector<T>& arr, int low, int high, Compare comp) {
     }
 }
 
-/*
-    Merges two sorted halves of a vector of Actor pointers based on their ratings
-
-    This function merges two sorted sub-arrays of a vector containing Actor pointers
-	It compares the ratings of the actors to determine the order in which they are merged
-
-    Parameter - arr: The vector of Actor pointers to merge
-    Parameter - left: The starting index of the left sub-array
-    Parameter - mid: The midpoint index where the array is split
-    Parameter - right: The ending index of the right sub-array
-    Return - None (modifies the input vector in place)
-*/
-void mergeActorsByRating(vector<Actor*>& arr, int left, int mid, int right) {
-    int n1 = mid - left + 1;  // Size of the left sub-array
-    int n2 = right - mid;     // Size of the right sub-array
-
-    // Create temporary vectors to store the left and right sub-arrays
-    vector<Actor*> L(n1), R(n2);
-    for (int i = 0; i < n1; i++)
-        L[i] = arr[left + i];  // Copy elements to the left sub-array
-    for (int i = 0; i < n2; i++)
-        R[i] = arr[mid + 1 + i];  // Copy elements to the right sub-array
-
-    int i = 0, j = 0, k = left;  // Initialize indices for merging
-
-    // Merge the two sub-arrays back into the original array in sorted order
-    while (i < n1 && j < n2) {
-        if (L[i]->rating >= R[j]->rating) {  // Compare ratings
-            arr[k] = L[i];  // Take the element from the left sub-array
-            i++;
-        }
-        else {
-            arr[k] = R[j];  // Take the element from the right sub-array
-            j++;
-        }
-        k++;
-    }
-
-    // Copy any remaining elements from the left sub-array
-    while (i < n1) {
-        arr[k] = L[i];
-        i++;
-        k++;
-    }
-
-    // Copy any remaining elements from the right sub-array
-    while (j < n2) {
-        arr[k] = R[j];
-        j++;
-        k++;
-    }
-}
-
-/*
-    Sorts a vector of Actor pointers by rating using the merge sort algorithm
-
-    This function recursively divides the vector into two halves, sorts each half
-    and then merges them in descending order based on actor ratings
-
-    Parameter - arr: The vector of Actor pointers to sort
-    Parameter - left: The starting index of the sorting range
-    Parameter - right: The ending index of the sorting range
-    Return - None (modifies the input vector in place)
-*/
-void mergeSortActorsByRating(vector<Actor*>& arr, int left, int right) {
-    if (left < right) {
-        int mid = left + (right - left) / 2;  // Find the middle point
-        mergeSortActorsByRating(arr, left, mid);  // Sort the left half
-        mergeSortActorsByRating(arr, mid + 1, right);  // Sort the right half
-        mergeActorsByRating(arr, left, mid, right);  // Merge the sorted halves
-    }
-}
-
-/*
-    Merges two sorted halves of a vector of Movie pointers based on their ratings
-
-    This function merges two sorted sub-arrays of a vector containing Movie pointers
-    It ensures that the movies are ordered in descending order of their ratings
-
-    Parameter - arr: The vector of Movie pointers to merge
-    Parameter - left: The starting index of the left sub-array
-    Parameter - mid: The midpoint index where the array is split
-    Parameter - right: The ending index of the right sub-array
-    Return - None (modifies the input vector in place)
-*/
-void mergeMoviesByRating(vector<Movie*>& arr, int left, int mid, int right) {
-    int n1 = mid - left + 1;  // Size of the left sub-array
-    int n2 = right - mid;     // Size of the right sub-array
-
-    // Create temporary vectors to store the left and right sub-arrays
-    vector<Movie*> L(n1), R(n2);
-    for (int i = 0; i < n1; i++)
-        L[i] = arr[left + i];  // Copy elements to the left sub-array
-    for (int i = 0; i < n2; i++)
-        R[i] = arr[mid + 1 + i];  // Copy elements to the right sub-array
-
-    int i = 0, j = 0, k = left;  // Initialize indices for merging
-
-    // Merge the two sub-arrays back into the original array in sorted order
-    while (i < n1 && j < n2) {
-        if (L[i]->rating >= R[j]->rating) {  // Compare ratings
-            arr[k] = L[i];  // Take the element from the left sub-array
-            i++;
-        }
-        else {
-            arr[k] = R[j];  // Take the element from the right sub-array
-            j++;
-        }
-        k++;
-    }
-
-    // Copy any remaining elements from the left sub-array
-    while (i < n1) {
-        arr[k] = L[i];
-        i++;
-        k++;
-    }
-
-    // Copy any remaining elements from the right sub-array
-    while (j < n2) {
-        arr[k] = R[j];
-        j++;
-        k++;
-    }
-}
-
-/*
-    Sorts a vector of Movie pointers by rating using the merge sort algorithm
-
-    This function recursively divides the vector into two halves, sorts each half
-    and then merges them in descending order based on movie ratings
-
-    Parameter - arr: The vector of Movie pointers to sort
-    Parameter - left: The starting index of the sorting range
-    Parameter - right: The ending index of the sorting range
-    Return - None (modifies the input vector in place)
-*/
-void mergeSortMoviesByRating(vector<Movie*>& arr, int left, int right) {
-    if (left < right) {
-        int mid = left + (right - left) / 2;  // Find the middle point
-        mergeSortMoviesByRating(arr, left, mid);  // Sort the left half
-        mergeSortMoviesByRating(arr, mid + 1, right);  // Sort the right half
-        mergeMoviesByRating(arr, left, mid, right);  // Merge the sorted halves
-    }
-}
-
-
-
 /*
     Displays the top 10 highest-rated actors
 
@@ -507,6 +512,8 @@ void displayTopMovies(const vector<Movie*>& movies) {
     This function reads a CSV file containing actor-movie relationships and updates
     the actor dictionary, movie dictionary, and actor-movie graph accordingly
 	It validates actor and movie IDs before adding cast relationships
+    The IDs are parsed straight from the line buffer, so no strings are allocated per record,
+    and are then looked up in batches with getMany so the cache misses of many records overlap
 
     Parameter - fileName: The name or path of the CSV file containing cast data
     Return - None (updates the dictionaries and graph, logs errors if entries are missing)
@@ -517,32 +524,45 @@ void loadCastsFromCSV(const string& fileName) {
         cout << "[Error] Failed to open " << fileName << endl;
         return;
     }
+    // Parse every record first, so the IDs can be looked up in batches
+    vector<RecordId> actorIds, movieIds;
     string line;
     getline(file, line); // Skip header
     while (getline(file, line)) {
-        stringstream ss(line);
-        string actorId, movieId;
-        getline(ss, actorId, ',');
-        getline(ss, movieId, ',');
-        if (actorId.empty() || movieId.empty()) {
+        // Split the two IDs out of the line buffer and parse them without copying
+        string_view fields(line);
+        size_t comma = fields.find(',');
+        string_view actorField = fields.substr(0, comma);
+        string_view movieField = (comma == string_view::npos) ? string_view() : fields.substr(comma + 1);
+        movieField = movieField.substr(0, movieField.find(','));
+
+        RecordId actorId, movieId;
+        if (!parseRecordId(actorField, actorId) || !parseRecordId(movieField, movieId)) {
             cout << "[Warning] Skipping invalid cast record: " << line << endl;
             continue;
         }
-        Actor* actor = actorDictionary.get(actorId);
-        Movie* movie = movieDictionary.get(movieId);
+        actorIds.push_back(actorId);
+        movieIds.push_back(movieId);
+    }
+    file.close();
+
+    // Resolve all the IDs with batched lookups (see Dictionary::getMany)
+    vector<Actor*> actors;
+    vector<Movie*> movies;
+    actorDictionary.getMany(actorIds, actors);
+    movieDictionary.getMany(movieIds, movies);
+
+    for (size_t i = 0; i < actorIds.size(); i++) {
+        Actor* actor = actors[i];
+        Movie* movie = movies[i];
         if (!actor || !movie) {
-            cout << "[Warning] Actor or Movie not found for IDs (" << actorId << ", " << movieId << "). Skipping record.\n";
+            cout << "[Warning] Actor or Movie not found for IDs (" << actorIds[i] << ", " << movieIds[i] << "). Skipping record.\n";
             continue;
         }
         actor->addMovie(movie);
         movie->addActor(actor);
-        if (!actorMovieGraph.nodeExists(actor->name))
-            actorMovieGraph.addNode(actor->name);
-        if (!actorMovieGraph.nodeExists(movie->title))
-            actorMovieGraph.addNode(movie->title);
-        actorMovieGraph.addEdge(actor->name, movie->title);
+        actorMovieGraph.addEdge(actor->id, movie->id);
     }
-    file.close();
     cout << "[Info] Casts loaded successfully from " << fileName << endl;
 }
 
@@ -691,7 +711,7 @@ void storeDataToCsv() {
 void addActor() {
 
     // Prompt user to enter a ID for new actor
-    string id = getNonEmptyInput("Enter Actor ID: ");
+    RecordId id = getIdInput("Enter Actor ID: ");
 
     // Prompt user to enter name for new actor
     string name = getNonEmptyInput("Enter Actor Name: ");
@@ -721,25 +741,25 @@ void addActor() {
         }
     }
 
-    // Create a new Actor object with the provided ID, name, and birth year
-    Actor* newActor = new Actor(id, name, birthYear);
+    // Attempt to create the new actor in the actorDictionary (which owns the record)
+    Actor* newActor = actorDictionary.emplace(id, id, name, birthYear);
+    if (newActor) {
 
-    // Attempt to add the new actor to the actorDictionary
-    if (actorDictionary.add(id, newActor)) {
-
-        // If successful, print a success message and add the actor to the newActors list
+        // If successful, print a success message and add the actor to the newActors list and name index
         cout << "[Success] Actor \"" << name << "\" (ID: " << id << ") added successfully!\n";
         newActors.push_back(newActor);
+        actorNameIndex.add(name, newActor);
+        actorBirthYearIndex.add(birthYear, newActor);
+        actorRatingIndex.add(newActor->rating, newActor);
     }
     else {
-        // If the actor ID already exists, print an error message and clean up the new actor object
+        // If the actor ID already exists, print an error message
         cout << "[Error] Actor with ID \"" << id << "\" already exists.\n";
-        delete newActor;
         return;  // Exit the function as the actor cannot be added
     }
 
-    // Add the actor's name as a node in the actor-movie graph
-    actorMovieGraph.addNode(name);
+    // Add the actor's ID as a vertex in the actor-movie graph
+    actorMovieGraph.addActor(id);
 
     // Print a success message indicating the actor was added to graph
     cout << "[Success] Actor added to and Graph.\n";
@@ -756,7 +776,7 @@ void addActor() {
 */
 void addMovie() {
     // Prompt user to enter an ID for new movie
-    string id = getNonEmptyInput("Enter Movie ID: ");
+    RecordId id = getIdInput("Enter Movie ID: ");
 
     // Prompt user to enter title for new movie
     string title = getNonEmptyInput("Enter Movie Title: ");
@@ -774,22 +794,22 @@ void addMovie() {
             cout << "[Error] Invalid year. Please enter a year containing only digits.\n";
     }
 
-    // Create a new Movie object with the provided ID, title, plot, and year
-    Movie* newMovie = new Movie(id, title, plot, year);
-
-    // Attempt to add the new movie to the movieDictionary
-    if (movieDictionary.add(id, newMovie)) {
+    // Attempt to create the new movie in the movieDictionary (which owns the record)
+    Movie* newMovie = movieDictionary.emplace(id, id, title, plot, year);
+    if (newMovie) {
         cout << "[Success] Movie \"" << title << "\" (ID: " << id << ") added successfully!\n";
         newMovies.push_back(newMovie);
+        movieTitleIndex.add(title, newMovie);
+        movieYearIndex.add(newMovie->getYearAsInt(), newMovie);
+        movieRatingIndex.add(newMovie->rating, newMovie);
     }
     else {
         cout << "[Error] Movie with ID \"" << id << "\" already exists.\n";
-        delete newMovie;
         return;
     }
 
-    // Add the movie's title as a node in the actor-movie graph
-    actorMovieGraph.addNode(title);
+    // Add the movie's ID as a vertex in the actor-movie graph
+    actorMovieGraph.addMovie(id);
 
     cout << "[Success] Movie added to Graph.\n";
 }
@@ -806,10 +826,10 @@ void addMovie() {
 */
 void addActorToMovie() {
 	// Prompt user to enter Actor ID
-    string actorId = getNonEmptyInput("Enter Actor ID: ");
+    RecordId actorId = getIdInput("Enter Actor ID: ");
 
 	// Prompt user to enter Movie ID
-    string movieId = getNonEmptyInput("Enter Movie ID: ");
+    RecordId movieId = getIdInput("Enter Movie ID: ");
 
 	// Check if the actor and movie exist in the dictionaries
     Actor* actor = actorDictionary.get(actorId);
@@ -817,29 +837,15 @@ void addActorToMovie() {
 
 	// If both the actor and movie exist, check if the actor is already in the movie
     if (actor && movie) {
-        bool alreadyCast = false;
-        for (const Movie* m : actor->movies) {
-            if (m->id == movieId) {
+        if (actorMovieGraph.hasEdge(actorId, movieId)) {
 
-				// If the actor is already in the movie, print an error message and return
-                alreadyCast = true;
-                break;
-            }
-        }
-        if (alreadyCast) {
+			// If the actor is already in the movie, print an error message and return
             cout << "[Error] Actor \"" << actor->name << "\" is already in movie \"" << movie->title << "\".\n";
             return;
         }
-        
-        if (!actorMovieGraph.nodeExists(actor->name)) {
-            actorMovieGraph.addNode(actor->name);
-        }
 
-        if (!actorMovieGraph.nodeExists(movie->title)) {
-            actorMovieGraph.addNode(movie->title);
-        }
 		// Add a new edge to the actor-movie graph and update the actor and movie objects
-        actorMovieGraph.addEdge(actor->name, movie->title);
+        actorMovieGraph.addEdge(actorId, movieId);
 
 		// Add the actor to the movie and the movie to the actor
         actor->addMovie(movie);
@@ -864,15 +870,16 @@ void addActorToMovie() {
 
     This function allows the user to update an actor's name, birth year, or both
     It verifies that the actor exists in the dictionary before making any changes
-    If the name is updated, it also updates the actor's name in the actor-movie graph
+    If the name is updated, it also moves the actor in the name index. The actor-movie graph is keyed
+    by Actor ID, so it is not touched by a rename
 
     Parameter - None 
-    Return - None (updates the actor dictionary and graph)
+    Return - None (updates the actor record and its secondary indexes)
 */
 void updateActorDetails() {
     
 	// Prompt user to enter Actor ID to update
-    string actorId = getNonEmptyInput("Enter Actor ID to update: ");
+    RecordId actorId = getIdInput("Enter Actor ID to update: ");
 
 	// Check if the actor exists in the dictionary
     Actor* actor = actorDictionary.get(actorId);
@@ -899,8 +906,9 @@ void updateActorDetails() {
         string oldName = actor->name;
         string newName = getNonEmptyInput("Enter new Name (current: " + actor->name + "): ");
         actor->name = newName;
-        if (oldName != newName)
-            actorMovieGraph.updateNode(oldName, newName);
+        if (oldName != newName) {
+            actorNameIndex.rename(oldName, newName, actor);
+        }
     }
 
 	// Update the actor's birth year
@@ -916,6 +924,7 @@ void updateActorDetails() {
             }
             else {
                 cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                actorBirthYearIndex.rekey(actor->birthYear, newBirthYear, actor);
                 actor->birthYear = newBirthYear;
                 break;
             }
@@ -932,15 +941,16 @@ void updateActorDetails() {
 
     This function allows the user to update a movie's title, plot, year, or all fields
     It verifies that the movie exists in the dictionary before making any changes
-    If the title is updated, it also updates the movie's title in the actor-movie graph
+    If the title is updated, it also moves the movie in the title index. The actor-movie graph is keyed
+    by Movie ID, so it is not touched by a rename
 
     Parameter - None 
-    Return - None (updates the movie dictionary and graph)
+    Return - None (updates the movie record and its secondary indexes)
 */
 void updateMovieDetails() {
 
     // Prompt user to enter Movie ID to update
-    string movieId = getNonEmptyInput("Enter Movie ID to update: ");
+    RecordId movieId = getIdInput("Enter Movie ID to update: ");
 
     // Check if the movie exists in the dictionary
     Movie* movie = movieDictionary.get(movieId);
@@ -976,8 +986,9 @@ void updateMovieDetails() {
 
         movie->titleWasQuoted = (toupper(quoteChoice) == 'Y');
 
-        if (oldTitle != newTitle)
-            actorMovieGraph.updateNode(oldTitle, newTitle);
+        if (oldTitle != newTitle) {
+            movieTitleIndex.rename(oldTitle, newTitle, movie);
+        }
     }
 
     // Update the movie's plot
@@ -999,6 +1010,7 @@ void updateMovieDetails() {
             }
             else {
                 cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                movieYearIndex.rekey(movie->getYearAsInt(), newYear, movie);
                 movie->year = to_string(newYear);
                 break;
             }
@@ -1034,6 +1046,182 @@ void updateDetails() {
     }
 }
 
+/*
+    Prints the statistics of one hash table
+
+    Parameter - name: The name of the table to show in the heading
+    Parameter - stats: The statistics to print
+    Return - None (prints the statistics)
+*/
+void printHashTableStats(const string& name, const HashTableStats& stats) {
+    cout << "\n" << name << ": " << stats.size << " entries in " << stats.capacity << " slots ("
+        << stats.groups << " groups of " << HASH_TABLE_GROUP_SIZE << "), " << stats.tombstones << " tombstones\n";
+    ostringstream average;
+    average << fixed << setprecision(3) << stats.averageProbeLength;
+    cout << "  Probe length (groups visited): max " << stats.maxProbeLength << ", average " << average.str() << "\n";
+    cout << "  Entries per group:";
+    for (size_t k = 0; k < stats.groupOccupancy.size(); k++) {
+        if (stats.groupOccupancy[k] > 0)
+            cout << " " << k << ":" << stats.groupOccupancy[k];
+    }
+    cout << "\n";
+}
+
+/*
+    Lists the actors or movies whose IDs fall in a range
+
+    This function prompts for actors or movies and a range of IDs, and prints the matching records
+    in ascending ID order one page at a time. The records are read from the dictionary's ordered index,
+    so only the listed records are visited.
+
+    Parameter - None
+    Return - None (prints the records in the range)
+*/
+void listRecordsByIdRange() {
+    const int pageSize = 20;
+
+    cout << "\nDo you want to list Actors or Movies? (A/M): ";
+    char choice;
+    cin >> choice;
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    choice = toupper(choice);
+    if (choice != 'A' && choice != 'M') {
+        cout << "[Error] Invalid choice.\n";
+        return;
+    }
+
+    RecordId low = getIdInput("Enter the lowest ID: ");
+    RecordId high = getIdInput("Enter the highest ID: ");
+    if (high < low) {
+        cout << "[Error] The highest ID must not be lower than the lowest ID.\n";
+        return;
+    }
+
+    // Each page starts at the ID after the last one shown
+    RecordId pageStart = low;
+    while (true) {
+        int shown = 0;
+        RecordId lastId = 0;
+        if (choice == 'A') {
+            actorDictionary.forEachFrom(pageStart, pageSize, [&](Actor* actor) {
+                if (actor->id > high)
+                    return;
+                cout << "  " << actor->id << " - " << actor->name << " (born " << actor->birthYear << ")\n";
+                lastId = actor->id;
+                shown++;
+            });
+        }
+        else {
+            movieDictionary.forEachFrom(pageStart, pageSize, [&](Movie* movie) {
+                if (movie->id > high)
+                    return;
+                cout << "  " << movie->id << " - " << movie->title << " (" << movie->year << ")\n";
+                lastId = movie->id;
+                shown++;
+            });
+        }
+
+        if (shown == 0 && pageStart == low) {
+            cout << "[Info] No records found in this ID range.\n";
+            return;
+        }
+        if (shown < pageSize || lastId == high)
+            return;
+
+        cout << "Show the next page? (Y/N): ";
+        char next;
+        cin >> next;
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        if (toupper(next) != 'Y')
+            return;
+        pageStart = lastId + 1;
+    }
+}
+
+/*
+    Prints the statistics of one frozen (perfect hash) table
+
+    Parameter - name: The name of the table to show in the heading
+    Parameter - stats: The statistics to print
+    Parameter - liveEntries: The number of frozen entries not removed since the freeze
+    Return - None (prints the statistics)
+*/
+void printPerfectHashStats(const string& name, const PerfectHashStats& stats, int liveEntries) {
+    cout << "\n" << name << ": " << stats.size << " slots (" << liveEntries << " not removed), "
+        << stats.buckets << " buckets, built with " << stats.attempts << (stats.attempts == 1 ? " seed\n" : " seeds\n");
+    cout << "  Keys per bucket:";
+    for (size_t k = 0; k < stats.bucketOccupancy.size(); k++) {
+        if (stats.bucketOccupancy[k] > 0)
+            cout << " " << k << ":" << stats.bucketOccupancy[k];
+    }
+    ostringstream average;
+    average << fixed << setprecision(1) << stats.averageDisplacement;
+    cout << "\n  Displacement: max " << stats.maxDisplacement << ", average " << average.str() << "\n";
+    cout << "  Displacements by range:";
+    for (size_t i = 0; i < stats.displacementCounts.size(); i++) {
+        if (stats.displacementCounts[i] == 0)
+            continue;
+        if (i == 0)
+            cout << " 0:";
+        else if (i == 1)
+            cout << " 1:";
+        else
+            cout << " " << (1u << (i - 1)) << "-" << (1u << i) - 1 << ":";
+        cout << stats.displacementCounts[i];
+    }
+    cout << "\n";
+}
+
+/*
+    Prints the counters of one Bloom filter
+
+    Parameter - name: The name of the dictionary the filter belongs to
+    Parameter - stats: The counters to print
+    Return - None (prints the counters)
+*/
+void printBloomFilterStats(const string& name, const BloomFilterStats& stats) {
+    if (stats.memoryBytes == 0) {
+        cout << name << " Bloom filter: not enabled\n";
+        return;
+    }
+
+    ostringstream rates;
+    rates << fixed << setprecision(1);
+    if (stats.queries > 0) {
+        long long passed = stats.queries - stats.rejected;
+        rates << 100.0 * stats.rejected / stats.queries << "% rejected by the filter, "
+            << 100.0 * (passed - stats.falsePositives) / stats.queries << "% found, "
+            << 100.0 * stats.falsePositives / stats.queries << "% false positives";
+    }
+    cout << name << " Bloom filter: " << stats.keys << " keys (sized for " << stats.capacity << "), "
+        << stats.memoryBytes / 1024 << " KB, " << stats.hashCount << " bits set per key\n";
+    cout << "  " << stats.queries << " lookups: " << rates.str() << "\n";
+}
+
+/*
+    Displays how evenly the actor and movie IDs and names are spread over their hash tables
+
+    This function is used to check the hash function against the loaded data. The IDs loaded at startup
+    are in the frozen perfect hash tables, where large buckets and displacements mean the keys were hard
+    to place. For the other tables, a long maximum probe length or many full groups means lookups of some
+    keys are slower than they should be.
+
+    Parameter - None
+    Return - None (prints the statistics of every table)
+*/
+void displayHashTableStats() {
+    printPerfectHashStats("Actors by ID (frozen)", actorDictionary.getFrozenStats(), actorDictionary.getFrozenSize());
+    printPerfectHashStats("Movies by ID (frozen)", movieDictionary.getFrozenStats(), movieDictionary.getFrozenSize());
+    cout << "\n";
+    printBloomFilterStats("Actors by ID", actorDictionary.getBloomStats());
+    printBloomFilterStats("Movies by ID", movieDictionary.getBloomStats());
+    printHashTableStats("Actors by ID (added since freeze)", actorDictionary.getStats());
+    printHashTableStats("Movies by ID (added since freeze)", movieDictionary.getStats());
+    printHashTableStats("Actors by name", actorNameIndex.getStats());
+    printHashTableStats("Movies by title", movieTitleIndex.getStats());
+    cout << endl;
+}
+
 /*
     Displays movies released within the past three years of a given year
 
@@ -1064,20 +1252,13 @@ void displayRecentMovies() {
     }
     // Get Movies 3 years past the year prompted
     int lowerBound = baseYear - 3;
-    vector<Movie*> allMovies = movieDictionary.getAllItems();
     vector<Movie*> recentMovies;
 
-	// Loop through all movies and add to recentMovies if the year is within the range
-    for (Movie* movie : allMovies) {
-        int movieYear = movie->getYearAsInt();
-        if (movieYear > 0 && movieYear >= lowerBound && movieYear <= baseYear)
-            recentMovies.push_back(movie);
-    }
-    if (!recentMovies.empty()) {
-        quickSort(recentMovies, 0, recentMovies.size() - 1, [](Movie* a, Movie* b) {
-            return a->getYearAsInt() <= b->getYearAsInt();
-            });
-    }
+	// Read the movies in the year range from the year index, already in ascending order by year
+	// (movies without a valid year are filed under -1 and are never in range)
+    movieYearIndex.forEachInRange(max(lowerBound, 1), baseYear, [&](Movie* movie) {
+        recentMovies.push_back(movie);
+    });
 
 	// Display the recent movies
     cout << "\nRecent Movies (From " << lowerBound << " to " << baseYear << "):\n";
@@ -1134,22 +1315,12 @@ void displayActorsByAgeRange() {
         }
     }
 
-    // Retrieve all actors from the dictionary and filter those within the specified age range
-    vector<Actor*> allActors = actorDictionary.getAllItems();
+    // Read the actors born between (currentYear - y) and (currentYear - x) from the birth year index.
+    // Walking the birth years from latest to earliest gives the actors in ascending order of age.
     vector<Actor*> filteredActors;
-    for (Actor* actor : allActors) {
-        int age = currentYear - actor->birthYear;
-        if (age >= x && age <= y) {
-            filteredActors.push_back(actor);
-        }
-    }
-
-    // Sort filtered actors by age in ascending order using quickSort
-    if (!filteredActors.empty()) {
-        quickSort(filteredActors, 0, filteredActors.size() - 1, [currentYear](Actor* a, Actor* b) {
-            return (currentYear - a->birthYear) < (currentYear - b->birthYear);
-            });
-    }
+    actorBirthYearIndex.forEachInRangeDescending(currentYear - y, currentYear - x, [&](Actor* actor) {
+        filteredActors.push_back(actor);
+    });
 
     // Display the sorted list of actors
     cout << "\n=====================================" << endl;
@@ -1168,11 +1339,39 @@ void displayActorsByAgeRange() {
 }
 
 
+/*
+    Looks up the records of the movies an actor is cast in
+
+    This function takes the actor's movie IDs from the actor-movie graph and resolves them
+    in one batch through movieDictionary.
+
+    Parameter - actorId: The ID of the actor
+    Return - The actor's movies, in the order they were cast
+*/
+vector<Movie*> getCastMovies(RecordId actorId) {
+    vector<Movie*> movies;
+    movieDictionary.getMany(actorMovieGraph.getMovies(actorId), movies);
+    return movies;
+}
+
+/*
+    Looks up the records of the actors cast in a movie
+
+    Parameter - movieId: The ID of the movie
+    Return - The movie's actors, in the order they were cast
+*/
+vector<Actor*> getCastActors(RecordId movieId) {
+    vector<Actor*> actors;
+    actorDictionary.getMany(actorMovieGraph.getActors(movieId), actors);
+    return actors;
+}
+
 /*
     Displays all movies an actor has starred in
 
-	This function prompts the user to enter an actor's name and checks if they exist,
-	then retrieves and displays all movies the actor has starred in.
+	This function prompts the user to enter an actor's name, finds the actor through the name index
+	and checks if they are in the actor-movie graph, then displays all movies the actor has starred in
+	sorted by title.
 
     Parameter - None
     Return - None (displays the list of movies the actor has starred in)
@@ -1183,26 +1382,32 @@ void getMoviesByActor() {
     string actorName = getNonEmptyInput("Enter actor name: ");
 
 	// Check if the actor exists in the graph
-    if (!actorMovieGraph.nodeExists(actorName)) {
+    Actor* actor = findActorByName(actorName);
+    if (!actor || !actorMovieGraph.hasActor(actor->id)) {
         cout << "[Error] Actor \"" << actorName << "\" is not found in the graph.\n";
         return;
     }
 
-	// Get all movies for the specified actor
-    vector<string> movies = actorMovieGraph.listMoviesForActor(actorName);
+	// Get all movies for the specified actor, sorted by title
+    vector<Movie*> movies = getCastMovies(actor->id);
+    if (!movies.empty()) {
+        quickSort(movies, 0, static_cast<int>(movies.size()) - 1, [](const Movie* a, const Movie* b) {
+            return a->title < b->title;
+        });
+    }
 
 	// Display the movies starred by the actor
-    cout << "\nMovies Starred by " << actorName << ":\n";
-    for (const string& movie : movies) {
-        cout << " - " << movie << "\n";
+    cout << "\nMovies Starred by " << actor->name << ":\n";
+    for (const Movie* movie : movies) {
+        cout << " - " << movie->title << "\n";
     }
 }
 
 /*
     Displays all actors who starred in a given movie
 
-	This function prompts the user to enter a movie title and checks if it exists in the actor-movie graph
-    If so, it retrieves all the actors and displays them, It also checks for quoted titles
+	This function prompts the user to enter a movie title and finds the movie through the title index
+    If it is in the actor-movie graph, it retrieves all the actors and displays them sorted by name
 
     Parameter - None 
     Return - None (displays the list of actors in the given movie)
@@ -1211,46 +1416,32 @@ void getActorsByMovie() {
     // Prompt the user for the movie title.
     string movieTitle = getNonEmptyInput("Enter movie title: ");
 
-    // First, check if the movie node exists exactly as entered.
-    if (!actorMovieGraph.nodeExists(movieTitle)) {
-        // Prepare a variant with quotes.
-        string quotedTitle = "\"" + movieTitle + "\"";
-        if (actorMovieGraph.nodeExists(quotedTitle)) {
-            movieTitle = quotedTitle;
-        }
-        else {
-            // Movie node not found in the graph.
-            // Instead of using movieDictionary.get (which uses the ID as key),
-            // search through all movies for a matching title.
-            Movie* movieObj = nullptr;
-            vector<Movie*> allMovies = movieDictionary.getAllItems();
-            for (Movie* m : allMovies) {
-                // Compare the stored title with the input title.
-                if (m->title == movieTitle) {
-                    movieObj = m;
-                    break;
-                }
-            }
-            if (movieObj) {
-                cout << "[Info] Movie \"" << movieTitle
-                    << "\" exists but has no cast recorded.\n";
-            }
-            else {
-                cout << "[Error] Movie \"" << movieTitle << "\" not found.\n";
-            }
-            return;
-        }
+    // Look the title up in the title index, which ignores quotes, case and extra spaces.
+    Movie* movie = findMovieByTitle(movieTitle);
+    if (!movie) {
+        cout << "[Error] Movie \"" << movieTitle << "\" not found.\n";
+        return;
+    }
+
+    // The graph vertex is the movie's ID.
+    if (!actorMovieGraph.hasMovie(movie->id)) {
+        cout << "[Info] Movie \"" << movie->title
+            << "\" exists but has no cast recorded.\n";
+        return;
     }
 
-    // Retrieve the list of actors from the graph.
-    vector<string> actors = actorMovieGraph.listActorsForMovie(movieTitle);
+    // Retrieve the list of actors from the graph, sorted by name.
+    vector<Actor*> actors = getCastActors(movie->id);
     if (actors.empty()) {
-        cout << "[Info] There are no actors in the movie \"" << movieTitle << "\".\n";
+        cout << "[Info] There are no actors in the movie \"" << movie->title << "\".\n";
     }
     else {
-        cout << "\nActors in " << movieTitle << ":\n";
-        for (const string& actor : actors) {
-            cout << " - " << actor << "\n";
+        quickSort(actors, 0, static_cast<int>(actors.size()) - 1, [](const Actor* a, const Actor* b) {
+            return a->name < b->name;
+        });
+        cout << "\nActors in " << movie->title << ":\n";
+        for (const Actor* actor : actors) {
+            cout << " - " << actor->name << "\n";
         }
     }
 }
@@ -1259,19 +1450,50 @@ void getActorsByMovie() {
 /*
     Displays all actors that a given actor knows
 
-    This function prompts the user to enter an actor's name and checks if they exist in the actor-movie graph 
-    If found, it performs a breadth-first search (BFS) to retrieve and display all actors the given actor is connected
+    This function prompts the user to enter an actor's name and checks if they are in the actor-movie graph 
+    If found, it displays every movie the actor starred in with their co-actors (direct connections),
+    then every movie of each co-actor with its actors (indirect connections)
+    Actors are compared by ID, so different actors sharing a name are kept apart
 
     Parameter - None
     Return - None (displays the list of known actors)
 */
 void displayKnownActors() {
     string actorName = getNonEmptyInput("Enter actor name: ");
-    if (!actorMovieGraph.nodeExists(actorName)) {
+    Actor* actor = findActorByName(actorName);
+    if (!actor || !actorMovieGraph.hasActor(actor->id)) {
         cout << "[Error] Actor \"" << actorName << "\" not found.\n";
         return;
     }
-    actorMovieGraph.bfs(actorName);
+
+    // Display the actor's movies and co-actors.
+    vector<Movie*> movies = getCastMovies(actor->id);
+    cout << actor->name << " starred in:\n";
+    for (const Movie* movie : movies) {
+        cout << "\n - " << movie->title << ":\n";
+        for (const Actor* coActor : getCastActors(movie->id)) {
+            if (coActor->id != actor->id)
+                cout << "    * " << coActor->name << "\n";
+        }
+    }
+
+    // Display the related actors, co-actors (second-level connections).
+    cout << "\n" << actor->name << " knows the following actors:\n";
+    for (const Movie* movie : movies) {
+        for (const Actor* coActor : getCastActors(movie->id)) {
+            if (coActor->id == actor->id)
+                continue;
+            cout << "\n - " << coActor->name << " starred in:\n";
+            for (const Movie* coActorMovie : getCastMovies(coActor->id)) {
+                cout << "    * In movie \"" << coActorMovie->title << "\":\n";
+                for (const Actor* secondLevel : getCastActors(coActorMovie->id)) {
+                    if (secondLevel->id != coActor->id && secondLevel->id != actor->id)
+                        cout << "      - " << secondLevel->name << "\n";
+                }
+            }
+        }
+    }
+    cout << endl;
 }
 
 /*
@@ -1300,17 +1522,8 @@ void rateMovieOrActor() {
         // Get actor name from user input
         string actorName = getNonEmptyInput("Enter the Actor Name to rate: ");
 
-        // Retrieve all actors from the dictionary
-        vector<Actor*> allActors = actorDictionary.getAllItems();
-        Actor* actor = nullptr; // Pointer to store the matched actor
-
-        // Search for the actor by name
-        for (Actor* a : allActors) {
-            if (a->name == actorName) {
-                actor = a;
-                break; // Stop search when found
-            }
-        }
+        // Look the actor up in the name index
+        Actor* actor = findActorByName(actorName);
 
         // If the actor is not found, display an error message
         if (!actor) {
@@ -1336,12 +1549,17 @@ void rateMovieOrActor() {
             }
         }
 
-        // Update the actor's rating using the `updateRating()` function
+        // Update the actor's rating using the `updateRating()` function and move it in the rating index
+        double oldRating = actor->rating;
         actor->updateRating(stars);
+        actorRatingIndex.rekey(oldRating, actor->rating, actor);
+        actorBirthYearIndex.refresh(actor->birthYear, actor);
 
-        // Display success message with the updated rating
+        // Display success message with the updated rating and the actor's place in the ranking
         cout << "[Success] Actor \"" << actor->name << "\" now has an average rating of "
             << actor->rating << " (" << actor->noOfTimesRated << " ratings).\n";
+        cout << "[Info] Ranked #" << actorRatingIndex.countAbove(actor->rating, actor) + 1
+            << " of " << actorRatingIndex.size() << " actors.\n";
     }
 
 	// Function to rate a Movie
@@ -1350,17 +1568,8 @@ void rateMovieOrActor() {
         // Get movie title from user input
         string movieTitle = getNonEmptyInput("Enter the Movie Title to rate: ");
 
-        // Retrieve all movies from the dictionary
-        vector<Movie*> allMovies = movieDictionary.getAllItems();
-        Movie* movie = nullptr; // Pointer to store the matched movie
-
-        // Search for the movie by title
-        for (Movie* m : allMovies) {
-            if (m->title == movieTitle) {
-                movie = m;
-                break; // Stop search when found
-            }
-        }
+        // Look the movie up in the title index
+        Movie* movie = findMovieByTitle(movieTitle);
 
         // If the movie is not found, display an error message
         if (!movie) {
@@ -1386,12 +1595,17 @@ void rateMovieOrActor() {
             }
         }
 
-        // Update the movie's rating using the `updateRating()` function
+        // Update the movie's rating using the `updateRating()` function and move it in the rating index
+        double oldRating = movie->rating;
         movie->updateRating(stars);
+        movieRatingIndex.rekey(oldRating, movie->rating, movie);
+        movieYearIndex.refresh(movie->getYearAsInt(), movie);
 
-        // Display success message with the updated rating
+        // Display success message with the updated rating and the movie's place in the ranking
         cout << "[Success] Movie \"" << movie->title << "\" now has an average rating of "
             << movie->rating << " (" << movie->noOfTimesRated << " ratings).\n";
+        cout << "[Info] Ranked #" << movieRatingIndex.countAbove(movie->rating, movie) + 1
+            << " of " << movieRatingIndex.size() << " movies.\n";
     }
 
     // If they didnt enter A or M , it prompts an error
@@ -1404,7 +1618,7 @@ void rateMovieOrActor() {
     Displays the top 10 highest-rated actors or movies
 
 	This function prompts the user to either view top 10 actors or movies and displays the top 10 based on rating,
-	It uses the mergeSortActorsByRating and mergeSortMoviesByRating functions to sort the actors and movies
+	It reads the 10 highest ratings straight from the end of the rating index instead of going through every actor or movie
 
 	Parameter - None
 	Return - None (displays the top 10 actors or movies)
@@ -1422,18 +1636,20 @@ void displayRating() {
 
 	// If the user chooses to view top 10 actors
     if (choice == 'A') {
-        vector<Actor*> actors = actorDictionary.getAllItems();
-        if (!actors.empty())
-            mergeSortActorsByRating(actors, 0, actors.size() - 1);
-        displayTopActors(actors);
+        vector<Actor*> topActors;
+        actorRatingIndex.forEachTop(10, [&topActors](Actor* actor) {
+            topActors.push_back(actor);
+        });
+        displayTopActors(topActors);
     }
 
 	// If the user chooses to view top 10 movies
     else if (choice == 'M') {
-        vector<Movie*> movies = movieDictionary.getAllItems();
-        if (!movies.empty())
-            mergeSortMoviesByRating(movies, 0, movies.size() - 1);
-        displayTopMovies(movies);
+        vector<Movie*> topMovies;
+        movieRatingIndex.forEachTop(10, [&topMovies](Movie* movie) {
+            topMovies.push_back(movie);
+        });
+        displayTopMovies(topMovies);
     }
     
 	// If they didnt enter A or M , it prompts an error
@@ -1442,6 +1658,66 @@ void displayRating() {
     }
 }
 
+/*
+    Displays the best rated actor or movie within a range of years
+
+	This function prompts for actors (by birth year) or movies (by release year) and a range of years,
+	then shows the highest-rated one in the range and the average rating of the rated ones.
+	The answer comes from the rating summaries kept in the year index, so it takes O(log n)
+	however many actors or movies fall in the range.
+
+	Parameter - None
+	Return - None (displays the best rated actor or movie and the average rating)
+*/
+void displayBestRatedInRange() {
+    cout << "\nDo you want to search Actors (by birth year) or Movies (by release year)? (A/M): ";
+    char choice;
+    cin >> choice;
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    choice = toupper(choice);
+    if (choice != 'A' && choice != 'M') {
+        cout << "[Error] Invalid choice. Please select 'A' for actors or 'M' for movies.\n";
+        return;
+    }
+
+    int fromYear = getYearInput("Enter the first year: ");
+    int toYear = getYearInput("Enter the last year: ");
+    if (toYear < fromYear) {
+        cout << "[Error] The last year must not be before the first year.\n";
+        return;
+    }
+
+    cout << "\n=====================================" << endl;
+    if (choice == 'A') {
+        RatingAggregate<Actor> summary = actorBirthYearIndex.aggregateInRange(fromYear, toYear);
+        cout << "Best Rated Actor Born " << fromYear << " - " << toYear << endl;
+        cout << "=====================================" << endl;
+        if (!summary.best) {
+            cout << "[Info] No rated actors found in this range.\n";
+            return;
+        }
+        ostringstream details;
+        details << fixed << setprecision(2)
+            << "Rating: " << summary.best->rating << " - " << summary.best->noOfTimesRated << " ratings\n"
+            << "Average rating of the " << summary.ratedCount << " rated actors in range: " << summary.averageRating() << "\n";
+        cout << "Name: " << summary.best->name << " (born " << summary.best->birthYear << ")\n" << details.str();
+    }
+    else {
+        RatingAggregate<Movie> summary = movieYearIndex.aggregateInRange(fromYear, toYear);
+        cout << "Best Rated Movie Released " << fromYear << " - " << toYear << endl;
+        cout << "=====================================" << endl;
+        if (!summary.best) {
+            cout << "[Info] No rated movies found in this range.\n";
+            return;
+        }
+        ostringstream details;
+        details << fixed << setprecision(2)
+            << "Rating: " << summary.best->rating << " - " << summary.best->noOfTimesRated << " ratings\n"
+            << "Average rating of the " << summary.ratedCount << " rated movies in range: " << summary.averageRating() << "\n";
+        cout << "Title: " << summary.best->title << " (" << summary.best->year << ")\n" << details.str();
+    }
+}
+
 // ==================== Main Function ====================
 int main() {
 
@@ -1449,9 +1725,23 @@ int main() {
     actorDictionary.loadFromCSV("../actors.csv", true);
     movieDictionary.loadFromCSV("../movies.csv", false);
 
+    // The ID sets barely change after loading, so switch them to perfect hash lookups
+    actorDictionary.freeze();
+    movieDictionary.freeze();
+
+    // Reject cast rows with unknown IDs before they reach the tables (1% false positives, about 10 bits per ID)
+    actorDictionary.enableBloomFilter(0.01);
+    movieDictionary.enableBloomFilter(0.01);
+
     // Load cast relationships
     loadCastsFromCSV("../cast.csv");
 
+    // The cast relationships rarely change after loading, so pack them into flat arrays
+    actorMovieGraph.compact();
+
+    // Build the secondary indexes over the loaded records
+    buildIndexes();
+
     while (true) {
 
 		// Display the main menu and prompt the user for a choice
@@ -1467,7 +1757,7 @@ int main() {
                 int adminChoice;
                 cin >> adminChoice;
                 cin.ignore(numeric_limits<streamsize>::max(), '\n');
-                if (adminChoice == 5) {
+                if (adminChoice == 7) {
                     cout << "[Info] Returning to Main Menu...\n";
                     break;
                 }
@@ -1476,6 +1766,8 @@ int main() {
                 case 2: addMovie(); break;
                 case 3: addActorToMovie(); break;
                 case 4: updateDetails(); break;
+                case 5: displayHashTableStats(); break;
+                case 6: listRecordsByIdRange(); break;
                 default: cout << "[Error] Invalid input, please try again.\n";
                 }
             }
@@ -1488,7 +1780,7 @@ int main() {
                 int userChoice;
                 cin >> userChoice;
                 cin.ignore(numeric_limits<streamsize>::max(), '\n');
-                if (userChoice == 8) {
+                if (userChoice == 9) {
                     cout << "[Info] Returning to Main Menu...\n";
                     break;
                 }
@@ -1500,6 +1792,7 @@ int main() {
                 case 5: displayKnownActors(); break;
                 case 6: rateMovieOrActor(); break;
                 case 7: displayRating(); break;
+                case 8: displayBestRatedInRange(); break;
                 default: cout << "[Error] Invalid input, please try again.\n";
                 }
             }
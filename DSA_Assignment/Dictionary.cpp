@@ -1,12 +1,12 @@
 #include "Dictionary.h"
 #include "Actor.h"
 #include "Movie.h"
-#include "AVLTree.h"
 
 #include <cctype>
 #include <sstream>
 #include <fstream>
 #include <stdexcept>
+#include <algorithm>
 
 using namespace std;
 
@@ -66,132 +66,293 @@ namespace {
 }   
 
 // Constructor for Dictionary
-template <typename KeyType, typename ValueType>
-Dictionary<KeyType, ValueType>::Dictionary() : size(0) {
-    for (int i = 0; i < MAX_SIZE; ++i) {
-        table[i] = nullptr;
-    }
+template <typename KeyType, typename ValueType, typename Hasher, typename OrderedIndex>
+Dictionary<KeyType, ValueType, Hasher, OrderedIndex>::Dictionary() : frozenCount(0), bloomFalsePositiveRate(0.0) {
 }
 
-// Virtual Destructor for Dictionary
-template <typename KeyType, typename ValueType>
-Dictionary<KeyType, ValueType>::~Dictionary() {
-    for (int i = 0; i < MAX_SIZE; ++i) {
-        if (table[i] != nullptr) {
-            delete table[i];
-        }  
-    }
+// Virtual Destructor for Dictionary (records created by emplace are freed with the arena)
+template <typename KeyType, typename ValueType, typename Hasher, typename OrderedIndex>
+Dictionary<KeyType, ValueType, Hasher, OrderedIndex>::~Dictionary() {
+}
+
+/*
+    Finds the frozen slot of a key
+
+    Parameter - key: The key to search for
+    Return - A pointer to the value in the key's frozen slot (which is nullptr if the key was removed),
+             or nullptr if the key was not in the dictionary at the last freeze
+*/
+template <typename KeyType, typename ValueType, typename Hasher, typename OrderedIndex>
+ValueType** Dictionary<KeyType, ValueType, Hasher, OrderedIndex>::findFrozen(KeyView key) const {
+    return const_cast<ValueType**>(frozen.find(key));
+}
+
+/*
+    Checks whether a key is in the dictionary
+
+    Parameter - key: The key to search for
+    Return - True if the key is in the frozen table or the hash table, false otherwise
+*/
+template <typename KeyType, typename ValueType, typename Hasher, typename OrderedIndex>
+bool Dictionary<KeyType, ValueType, Hasher, OrderedIndex>::contains(KeyView key) const {
+    ValueType** frozenValue = findFrozen(key);
+    if (frozenValue)
+        return *frozenValue != nullptr;
+    return table.find(key) != nullptr;
 }
 
 /*
-    Computes the hash value for a given key
+    Stores an entry whose key is not in the dictionary
 
-	This function calculates the hash value for a given key using a polynomial rolling hash function.
+    A key that was frozen and later removed still owns its frozen slot, so it goes back into that slot.
+    Any other key goes into the hash table. Either way the key is added to the Bloom filter if there is one,
+    and to the ordered index unless the caller rebuilds that itself.
+    The filter is rebuilt twice as large once it holds more keys than it was sized for.
 
-    Parameter - key: The key to be hashed
-    Return - An unsigned long representing the hash index within the table
+    Parameter - key: The key to be inserted
+    Parameter - value: A pointer to the value associated with the key
+    Parameter - addToOrderedIndex: False if the caller adds the key to the ordered index later
 */
-template <typename KeyType, typename ValueType>
-unsigned long Dictionary<KeyType, ValueType>::hash(const KeyType& key) const {
-    unsigned long hashValue = 0;
-    for (char c : key) {
-        hashValue = (hashValue * 31 + c) % MAX_SIZE;
+template <typename KeyType, typename ValueType, typename Hasher, typename OrderedIndex>
+void Dictionary<KeyType, ValueType, Hasher, OrderedIndex>::insertEntry(const KeyType& key, ValueType* value, bool addToOrderedIndex) {
+    ValueType** frozenValue = findFrozen(key);
+    if (frozenValue) {
+        *frozenValue = value;
+        frozenCount++;
+    }
+    else {
+        table.insert(key, value);
+    }
+
+    if (addToOrderedIndex)
+        orderedIndex.emplace(key, value);
+
+    if (bloom.isEnabled()) {
+        if (bloom.size() >= bloom.getCapacity())
+            rebuildBloomFilter(getSize() * 2);
+        else
+            bloom.add(table.hashOf(key));
     }
-    return hashValue;
 }
 
 /*
     Inserts a new key-value pair into the dictionary
 
-    This function inserts a key-value pair into the dictionary.
-    If the bucket's AVL tree does not exist, it creates a new one.
-    It also checks for duplicate keys before insertion to prevent overwriting.
+    This function inserts a key-value pair into the dictionary's hash table.
+    It checks both the frozen table and the hash table for duplicate keys before insertion to prevent overwriting.
+    The hash table grows itself when it gets too full.
 
     Parameter - key: The key to be inserted
     Parameter - value: A pointer to the value associated with the key
     Return - True if insertion is successful, false if the key already exists
 */
-template <typename KeyType, typename ValueType>
-bool Dictionary<KeyType, ValueType>::add(const KeyType& key, ValueType* value) {
+template <typename KeyType, typename ValueType, typename Hasher, typename OrderedIndex>
+bool Dictionary<KeyType, ValueType, Hasher, OrderedIndex>::add(const KeyType& key, ValueType* value) {
     if (!value) {
         cerr << "Error: Trying to add a null value for key: " << key << endl;
         return false;
     }
 
-    unsigned long index = hash(key);  // Compute the hash bucket index
-
-    // If the AVL tree for the bucket doesn't exist, create it
-    if (table[index] == nullptr) {
-        table[index] = new AVLTree<KeyValuePair<KeyType, ValueType>>();
-    }
-
-    // Create a KeyValuePair object
-    KeyValuePair<KeyType, ValueType> kvp(key, value);
-
-    // Check if the KeyValuePair already exists in the AVL tree
-    auto found = table[index]->find(kvp);
-    if (found != nullptr) {
+    if (contains(key)) {
         cerr << "Error: Duplicate key detected: " << key << endl;
         return false;  // Duplicate key, insertion fails
     }
-
-    // Insert the KeyValuePair into the AVL tree
-    table[index]->insert(kvp);
-    size++;  // Increment the size of the dictionary
+    insertEntry(key, value);
     return true;  // Successfully added
 }
 
 
 /*
-    Removes a key-value pair from the dictionary
+    Reserves room in the dictionary for a number of entries
 
+    Parameter - n: The number of entries the dictionary should be able to hold
+    Return - None
+*/
+template <typename KeyType, typename ValueType, typename Hasher, typename OrderedIndex>
+void Dictionary<KeyType, ValueType, Hasher, OrderedIndex>::reserve(int n) {
+    table.reserve(n);
+}
+
+/*
+    Adds a batch of records to the dictionary
 
-    This function removes the KVP from the dictionary by finding the respective AVL tree bucket based on the hash value,
-	and then removing the KVP from the AVL tree. The size of the dictionary is also decremented
+    This function sorts the rows by key, so duplicate keys end up next to each other and can be
+    found without a lookup, and the records are stored in the arena in key order.
+    The table is grown once for the whole batch before anything is inserted, and if the dictionary was empty
+    the ordered index is built straight from the sorted rows.
+    When a key appears more than once only its first row is kept, the same as adding the rows one by one.
+
+    Parameter - rows: The keys and records to add (the records are moved out of the vector)
+    Return - The keys of the rows that were not added because the key already existed
+*/
+template <typename KeyType, typename ValueType, typename Hasher, typename OrderedIndex>
+vector<KeyType> Dictionary<KeyType, ValueType, Hasher, OrderedIndex>::bulkLoad(vector<pair<KeyType, ValueType>>& rows) {
+    // Sort positions rather than the rows themselves, so no record is moved around while sorting
+    vector<int> order(rows.size());
+    for (size_t i = 0; i < rows.size(); i++) {
+        order[i] = static_cast<int>(i);
+    }
+    stable_sort(order.begin(), order.end(),
+        [&rows](int a, int b) { return rows[a].first < rows[b].first; });
+
+    vector<KeyType> duplicates;
+    bool wasEmpty = isEmpty();
+    vector<KeyValuePair<KeyType, ValueType>> added;     // Added entries in key order, to build the ordered index from
+    table.reserve(table.size() + static_cast<int>(rows.size()));
+    for (size_t i = 0; i < order.size(); i++) {
+        pair<KeyType, ValueType>& row = rows[order[i]];
+        bool duplicate = (i > 0 && rows[order[i - 1]].first == row.first) || (!wasEmpty && contains(row.first));
+        if (duplicate) {
+            cerr << "Error: Duplicate key detected: " << row.first << endl;
+            duplicates.push_back(row.first);
+            continue;
+        }
+        ValueType* value = records.create(move(row.second));
+        insertEntry(row.first, value, !wasEmpty);
+        if (wasEmpty)
+            added.push_back(KeyValuePair<KeyType, ValueType>(row.first, value));
+    }
+
+    // The rows are already sorted, so an empty dictionary gets its ordered index built in one pass
+    if (wasEmpty)
+        orderedIndex.buildFromSorted(added);
+    return duplicates;
+}
+
+/*
+    Removes a key-value pair from the dictionary
+
+    This function removes the KVP from the dictionary's hash table. The size of the dictionary is also decremented
+    A frozen key keeps its slot in the frozen table, only its value is cleared
 
     Parameter - key: The key associated with the value to be removed
     Return - True if the key was successfully removed, false if the key was not found
 */
-template <typename KeyType, typename ValueType>
-bool Dictionary<KeyType, ValueType>::remove(const KeyType& key) {
-    unsigned long index = hash(key);
-    if (table[index] == nullptr)
+template <typename KeyType, typename ValueType, typename Hasher, typename OrderedIndex>
+bool Dictionary<KeyType, ValueType, Hasher, OrderedIndex>::remove(KeyView key) {
+    ValueType** frozenValue = findFrozen(key);
+    if (frozenValue) {
+        if (!*frozenValue)
+            return false;
+        *frozenValue = nullptr;
+        frozenCount--;
+    }
+    else if (!table.erase(key)) {
         return false;
-
-    KeyValuePair<KeyType, ValueType> kvp(key, nullptr);
-
-    if (table[index]->find(kvp) == nullptr) {
-        return false;  
     }
-
-    table[index]->remove(kvp);
-    size--;
+    orderedIndex.remove(KeyType(key));
     return true;
 }
 
 /*
     Retrieves the value associated with a given key
 
-    This function searches the given key in the respective AVL tree bucket in the dictionary.
+    This function searches the given key in the frozen table first (one slot to check) and then in the hash table.
     If the key is found, the value is returned , if not it returns a nullptr
+    String keys can be passed as a string_view straight from a line buffer, no copy is made
+
+    Parameter - key: The key whose associated value is to be retrieved
+    Return - A pointer to the associated value (ValueType*) if found, otherwise nullptr
+*/
+template <typename KeyType, typename ValueType, typename Hasher, typename OrderedIndex>
+ValueType* Dictionary<KeyType, ValueType, Hasher, OrderedIndex>::get(KeyView key) const {
+    return getWithHash(key, table.hashOf(key));
+}
+
+/*
+    Finds the value of the smallest key that is not less than a given key
+
+    Parameter - key: The key to compare against
+    Return - A pointer to the value of the first key >= key, or nullptr if every key is smaller
+*/
+template <typename KeyType, typename ValueType, typename Hasher, typename OrderedIndex>
+ValueType* Dictionary<KeyType, ValueType, Hasher, OrderedIndex>::lowerBound(const KeyType& key) const {
+    typename OrderedIndex::const_iterator found = orderedIndex.lowerBound(key);
+    return found != orderedIndex.end() ? found->value : nullptr;
+}
+
+/*
+    Retrieves the value associated with a key whose hash is already known
+
+    The frozen table and the hash table use the same hasher, so one hash serves both lookups.
 
     Parameter - key: The key whose associated value is to be retrieved
+    Parameter - hashValue: The hash of the key
     Return - A pointer to the associated value (ValueType*) if found, otherwise nullptr
 */
-template <typename KeyType, typename ValueType>
-ValueType* Dictionary<KeyType, ValueType>::get(const KeyType& key) const {
-    unsigned long index = hash(key);
-    if (table[index] == nullptr) {
-        return nullptr;
+template <typename KeyType, typename ValueType, typename Hasher, typename OrderedIndex>
+ValueType* Dictionary<KeyType, ValueType, Hasher, OrderedIndex>::getWithHash(KeyView key, size_t hashValue) const {
+    if (bloom.isEnabled()) {
+        bloomStats.queries++;
+        if (!bloom.mayContain(hashValue)) {
+            bloomStats.rejected++;
+            return nullptr;
+        }
     }
 
-    KeyValuePair<KeyType, ValueType> kvp(key, nullptr);
-    auto found = table[index]->find(kvp);  // Find the KeyValuePair in the AVL tree
-    if (found != nullptr) {
-        return found->value;  // Return the value (ValueType*)
+    ValueType* value = nullptr;
+    ValueType* const* frozenValue = frozen.findWithHash(key, hashValue);
+    if (frozenValue) {
+        value = *frozenValue;
     }
+    else if (!table.isEmpty()) {
+        ValueType* const* found = table.findWithHash(key, hashValue);
+        value = found ? *found : nullptr;
+    }
+
+    if (!value && bloom.isEnabled())
+        bloomStats.falsePositives++;
+    return value;
+}
 
-    return nullptr;  // Return nullptr if the key is not found
+/*
+    Retrieves the values of a batch of keys
+
+    A single lookup stalls on every cache miss in turn. This function works through the keys in groups
+    of DICTIONARY_BATCH_SIZE: it first hashes every key of the group and prefetches the memory its lookup
+    reads first (the frozen displacement, or the hash table group), then prefetches the frozen slots,
+    and only then resolves the keys. The misses of all the keys in a group are then waited for together.
+
+    Parameter - keys: The keys to look up
+    Parameter - out: Receives one value pointer per key, in the same order (nullptr for keys that are not found)
+    Return - None
+*/
+template <typename KeyType, typename ValueType, typename Hasher, typename OrderedIndex>
+void Dictionary<KeyType, ValueType, Hasher, OrderedIndex>::getMany(const vector<KeyType>& keys, vector<ValueType*>& out) const {
+    out.resize(keys.size());
+    size_t hashes[DICTIONARY_BATCH_SIZE];
+    bool absent[DICTIONARY_BATCH_SIZE];
+    bool hasFrozen = !frozen.isEmpty();
+    bool hasTable = !table.isEmpty();
+
+    for (size_t start = 0; start < keys.size(); start += DICTIONARY_BATCH_SIZE) {
+        size_t batch = min(keys.size() - start, static_cast<size_t>(DICTIONARY_BATCH_SIZE));
+
+        // Keys the Bloom filter rejects are settled here and never touch the tables
+        for (size_t i = 0; i < batch; i++) {
+            hashes[i] = table.hashOf(keys[start + i]);
+            absent[i] = false;
+            if (bloom.isEnabled() && !bloom.mayContain(hashes[i])) {
+                bloomStats.queries++;
+                bloomStats.rejected++;
+                absent[i] = true;
+                continue;
+            }
+            if (hasFrozen)
+                frozen.prefetchBucket(hashes[i]);
+            if (hasTable)
+                table.prefetch(hashes[i]);
+        }
+        if (hasFrozen) {
+            for (size_t i = 0; i < batch; i++) {
+                if (!absent[i])
+                    frozen.prefetchSlot(hashes[i]);
+            }
+        }
+        for (size_t i = 0; i < batch; i++) {
+            out[start + i] = absent[i] ? nullptr : getWithHash(keys[start + i], hashes[i]);
+        }
+    }
 }
 
 
@@ -202,9 +363,9 @@ ValueType* Dictionary<KeyType, ValueType>::get(const KeyType& key) const {
 
     Return - True if the dictionary is empty, false otherwise
 */
-template <typename KeyType, typename ValueType>
-bool Dictionary<KeyType, ValueType>::isEmpty() const {
-    return size == 0;
+template <typename KeyType, typename ValueType, typename Hasher, typename OrderedIndex>
+bool Dictionary<KeyType, ValueType, Hasher, OrderedIndex>::isEmpty() const {
+    return frozenCount == 0 && table.isEmpty();
 }
 
 /*
@@ -215,71 +376,137 @@ bool Dictionary<KeyType, ValueType>::isEmpty() const {
     Return - The number of elements in the dictionary
 */
 
-template <typename KeyType, typename ValueType>
-int Dictionary<KeyType, ValueType>::getSize() const {
-    return size;
+template <typename KeyType, typename ValueType, typename Hasher, typename OrderedIndex>
+int Dictionary<KeyType, ValueType, Hasher, OrderedIndex>::getSize() const {
+    return frozenCount + table.size();
 }
 
 /*
     Prints the contents of the dictionary
 
-    This function iterates through all hash table buckets and prints the key-value
-    pairs stored in each AVL tree. It displays only non-empty buckets.
+    This function iterates through the dictionary and prints every key-value pair stored in it.
 
     Return - Void (Outputs dictionary contents to the console)
 */
-template <typename KeyType, typename ValueType>
-void Dictionary<KeyType, ValueType>::print() const {
-    for (int i = 0; i < MAX_SIZE; ++i) {
-        if (table[i] != nullptr) {
-            cout << "Bucket " << i << ":\n";
-            table[i]->displayInOrder();
-        }
+template <typename KeyType, typename ValueType, typename Hasher, typename OrderedIndex>
+void Dictionary<KeyType, ValueType, Hasher, OrderedIndex>::print() const {
+    for (const auto& entry : *this) {
+        cout << KeyValuePair<KeyType, ValueType>(entry.key, entry.value) << endl;
     }
 }
 
 /*
-    Retrieves all values stored in the dictionary
+    Retrieves statistics about the dictionary's hash table
 
-    This function iterates through all the hash table buckets and collects all values from the AVL trees into a vector
+    This function is used to check how well the keys are spread by the hasher (see HashTableStats).
+    Entries in the frozen table are not counted, since every one of them is found in a single slot.
 
-    Return - A vector containing pointers to all values stored in the dictionary
+    Return - The statistics of the hash table holding the entries added since the last freeze
 */
-template <typename KeyType, typename ValueType>
-vector<ValueType*> Dictionary<KeyType, ValueType>::getAllItems() const {
-    vector<ValueType*> items;
-    for (int i = 0; i < MAX_SIZE; ++i) {
-        if (table[i] != nullptr) {
-            vector<KeyValuePair<KeyType, ValueType>> bucketItems = table[i]->getAllItems();
-            for (const auto& kvp : bucketItems) {
-                items.push_back(kvp.value);
-            }
-        }
+template <typename KeyType, typename ValueType, typename Hasher, typename OrderedIndex>
+HashTableStats Dictionary<KeyType, ValueType, Hasher, OrderedIndex>::getStats() const {
+    return table.getStats();
+}
+
+/*
+    Freezes the dictionary into a perfect hash table
+
+    This function moves every entry (the ones already frozen and the ones added since) into a new
+    PerfectHashTable and empties the hash table. It should be called once loading is done; later additions
+    go into the hash table until freeze is called again. If the perfect hash cannot be built the dictionary
+    is left as it was.
+
+    Return - True if the dictionary was frozen, false otherwise
+*/
+template <typename KeyType, typename ValueType, typename Hasher, typename OrderedIndex>
+bool Dictionary<KeyType, ValueType, Hasher, OrderedIndex>::freeze() {
+    vector<typename PerfectHashTable<KeyType, ValueType*, Hasher>::Entry> entries;
+    entries.reserve(getSize());
+    for (const auto& entry : *this) {
+        entries.push_back(entry);
     }
-    return items;
+
+    PerfectHashTable<KeyType, ValueType*, Hasher> rebuilt;
+    if (!rebuilt.build(entries)) {
+        cerr << "[Warning] Could not build a perfect hash for " << entries.size() << " keys, dictionary not frozen." << endl;
+        return false;
+    }
+
+    frozen = move(rebuilt);
+    frozenCount = static_cast<int>(entries.size());
+    table.clear();
+
+    // Drop the keys removed since the filter was built
+    if (bloom.isEnabled())
+        rebuildBloomFilter(bloom.getCapacity());
+    return true;
 }
 
 /*
-    Retrieves all key-value pairs stored in the dictionary
+    Puts a Bloom filter in front of the dictionary's lookups
 
-    This function iterates through all the hash table buckets and collects all key-value pairs from the AVL trees into a vector
+    Once enabled, get and getMany check the filter before either table, so a key that is not in the
+    dictionary is usually rejected after reading one cache line. The filter is kept up to date as keys are
+    added, grows when it gets full and is rebuilt on freeze (removed keys stay in it until then).
+    Calling this again resizes the filter and resets its counters.
 
-    Return - A vector containing pointers to all key-value pairs in the dictionary
+    Parameter - falsePositiveRate: The accepted share of absent keys that still reach the tables (e.g. 0.01);
+                a lower rate uses more memory (about 10 bits per key at 1%)
+    Parameter - expectedKeys: The number of keys to size the filter for (0 uses the current size)
+    Return - None
 */
-template <typename KeyType, typename ValueType>
-vector<KeyValuePair<KeyType, ValueType>*> Dictionary<KeyType, ValueType>::getAllNodes() const {
-    vector<KeyValuePair<KeyType, ValueType>*> nodes;
-    for (int i = 0; i < MAX_SIZE; ++i) {
-        if (table[i] != nullptr) {
-            vector<KeyValuePair<KeyType, ValueType>> bucketItems = table[i]->getAllItems();
-            for (const auto& kvp : bucketItems) {
-                nodes.push_back(new KeyValuePair<KeyType, ValueType>(kvp.key, kvp.value));
-            }
-        }
+template <typename KeyType, typename ValueType, typename Hasher, typename OrderedIndex>
+void Dictionary<KeyType, ValueType, Hasher, OrderedIndex>::enableBloomFilter(double falsePositiveRate, int expectedKeys) {
+    bloomFalsePositiveRate = falsePositiveRate;
+    bloomStats = BloomFilterStats();
+    rebuildBloomFilter(max(expectedKeys, getSize()));
+}
+
+/*
+    Rebuilds the Bloom filter from the keys currently in the dictionary
+
+    Parameter - expectedKeys: The number of keys to size the filter for
+    Return - None
+*/
+template <typename KeyType, typename ValueType, typename Hasher, typename OrderedIndex>
+void Dictionary<KeyType, ValueType, Hasher, OrderedIndex>::rebuildBloomFilter(int expectedKeys) {
+    bloom.configure(max(expectedKeys, getSize()), bloomFalsePositiveRate);
+    for (const auto& entry : *this) {
+        bloom.add(table.hashOf(entry.key));
     }
-    return nodes;
 }
 
+/*
+    Retrieves the Bloom filter's counters
+
+    Return - The query, rejection and false positive counts and the size of the filter
+*/
+template <typename KeyType, typename ValueType, typename Hasher, typename OrderedIndex>
+BloomFilterStats Dictionary<KeyType, ValueType, Hasher, OrderedIndex>::getBloomStats() const {
+    BloomFilterStats stats = bloomStats;
+    stats.keys = bloom.size();
+    stats.capacity = bloom.getCapacity();
+    stats.hashCount = bloom.getHashCount();
+    stats.memoryBytes = bloom.memoryBytes();
+    return stats;
+}
+
+/*
+    Retrieves all values stored in the dictionary
+
+    This function iterates through the dictionary and collects all values into a vector
+
+    Return - A vector containing pointers to all values stored in the dictionary
+*/
+template <typename KeyType, typename ValueType, typename Hasher, typename OrderedIndex>
+vector<ValueType*> Dictionary<KeyType, ValueType, Hasher, OrderedIndex>::getAllItems() const {
+    vector<ValueType*> items;
+    items.reserve(getSize());
+    for (const auto& entry : *this) {
+        items.push_back(entry.value);
+    }
+    return items;
+}
 
 /*
     Parses a CSV line into individual fields
@@ -315,12 +542,13 @@ static vector<string> parseCSVLine(const string& line) {
     Return - True if the file is successfully loaded, false otherwise
 */
 template<>
-bool Dictionary<string, Movie>::loadFromCSV(const string& fileName, bool isActor) {
+bool Dictionary<RecordId, Movie>::loadFromCSV(const string& fileName, bool isActor) {
     ifstream file(fileName);
     if (!file.is_open()) {
         cerr << "[Error] Failed to open " << fileName << " for reading." << endl;
         return false;
     }
+    vector<pair<RecordId, Movie>> rows;    // Parsed records, added in one batch at the end
     string line;
     getline(file, line); // Skip header
     while (getline(file, line)) {
@@ -332,7 +560,11 @@ bool Dictionary<string, Movie>::loadFromCSV(const string& fileName, bool isActor
             continue;
         }
 
-        string id = fields[0];
+        RecordId id;
+        if (!parseRecordId(fields[0], id)) {
+            cerr << "[Warning] Skipping movie record with invalid ID: " << line << endl;
+            continue;
+        }
         string title = fields[1];
         bool titleWasQuoted = false;
         if (title.size() >= 2 && title.front() == '"' && title.back() == '"') {
@@ -344,16 +576,14 @@ bool Dictionary<string, Movie>::loadFromCSV(const string& fileName, bool isActor
         double rating = (fields.size() >= 5) ? stod(fields[4]) : 0.0;
         int noOfTimesRated = (fields.size() >= 6) ? stoi(fields[5]) : 0;
 
-        Movie* newMovie = new Movie(id, title, plot, year);
-        newMovie->rating = rating;
-        newMovie->noOfTimesRated = noOfTimesRated;
-        newMovie->titleWasQuoted = titleWasQuoted;
-        if (!this->add(id, newMovie)) {
-            cerr << "[Error] Duplicate movie ID: " << id << endl;
-            delete newMovie;
-        }
+        rows.emplace_back(id, Movie(id, title, plot, year, rating, noOfTimesRated));
+        rows.back().second.titleWasQuoted = titleWasQuoted;
     }
     file.close();
+
+    for (RecordId id : this->bulkLoad(rows)) {
+        cerr << "[Error] Duplicate movie ID: " << id << endl;
+    }
     cout << "[Info] Data loaded successfully from " << fileName << endl;
     return true;
 }
@@ -369,12 +599,13 @@ bool Dictionary<string, Movie>::loadFromCSV(const string& fileName, bool isActor
     Return - True if the file is successfully loaded, false otherwise
 */
 template<>
-bool Dictionary<string, Actor>::loadFromCSV(const string& fileName, bool isActor) {
+bool Dictionary<RecordId, Actor>::loadFromCSV(const string& fileName, bool isActor) {
     ifstream file(fileName);
     if (!file.is_open()) {
         cerr << "[Error] Failed to open " << fileName << " for reading." << endl;
         return false;
     }
+    vector<pair<RecordId, Actor>> rows;    // Parsed records, added in one batch at the end
     string line;
     getline(file, line); // Skip header
     while (getline(file, line)) {
@@ -386,21 +617,23 @@ bool Dictionary<string, Actor>::loadFromCSV(const string& fileName, bool isActor
             continue;
         }
 
-        string id = fields[0];
+        RecordId id;
+        if (!parseRecordId(fields[0], id)) {
+            cerr << "[Warning] Skipping actor record with invalid ID: " << line << endl;
+            continue;
+        }
         string name = fields[1];
         int birthYear = stoi(fields[2]);
         double rating = (fields.size() >= 4) ? stod(fields[3]) : 0.0;
         int noOfTimesRated = (fields.size() >= 5) ? stoi(fields[4]) : 0;
 
-        Actor* newActor = new Actor(id, name, birthYear);
-        newActor->rating = rating;
-        newActor->noOfTimesRated = noOfTimesRated;
-        if (!this->add(id, newActor)) {
-            cerr << "[Error] Duplicate actor ID: " << id << endl;
-            delete newActor;
-        }
+        rows.emplace_back(id, Actor(id, name, birthYear, rating, noOfTimesRated));
     }
     file.close();
+
+    for (RecordId id : this->bulkLoad(rows)) {
+        cerr << "[Error] Duplicate actor ID: " << id << endl;
+    }
     cout << "[Info] Data loaded successfully from " << fileName << endl;
     return true;
 }
@@ -415,8 +648,8 @@ bool Dictionary<string, Actor>::loadFromCSV(const string& fileName, bool isActor
     Parameter - isActor: A boolean flag indicating whether the file contains actor data
     Return - True if the file is successfully updated, false otherwise
 */
-template <typename KeyType, typename ValueType>
-bool Dictionary<KeyType, ValueType>::patchCSV(const string& fileName, bool isActor) {
+template <typename KeyType, typename ValueType, typename Hasher, typename OrderedIndex>
+bool Dictionary<KeyType, ValueType, Hasher, OrderedIndex>::patchCSV(const string& fileName, bool isActor) {
     ifstream inFile(fileName);
     if (!inFile.is_open()) {
         cerr << "[Error] Unable to open " << fileName << " for patching." << endl;
@@ -433,8 +666,8 @@ bool Dictionary<KeyType, ValueType>::patchCSV(const string& fileName, bool isAct
         vector<string> fields = parseCSVLine(line);
         if (fields.empty())
             continue;
-        string key = fields[0];
-        ValueType* obj = this->get(key);
+        RecordId key;
+        ValueType* obj = parseRecordId(fields[0], key) ? this->get(key) : nullptr;
         if (obj) {
             stringstream updatedLine;
             updatedLine << key << ",";
@@ -490,5 +723,5 @@ bool Dictionary<KeyType, ValueType>::patchCSV(const string& fileName, bool isAct
 }
 
 // Explicit template instantiation
-template class Dictionary<string, Actor>;
-template class Dictionary<string, Movie>;
+template class Dictionary<RecordId, Actor>;
+template class Dictionary<RecordId, Movie>;
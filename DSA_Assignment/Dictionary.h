@@ -4,18 +4,18 @@
 #include <string>
 #include <iostream>
 
-using namespace std;
+#include "HashTable.h"
+#include "RecordArena.h"
+#include "PerfectHashTable.h"
+#include "BloomFilter.h"
+#include "AVLTree.h"
+#include "BTree.h"
 
-// Using Prime Number for better hash distribution
-// 101 is the nearest prime number to 100
-const int MAX_SIZE = 101;
+using namespace std;
 
 class Actor;
 class Movie;
 
-template<typename T>
-class AVLTree;
-
 // Node structure
 template <typename KeyType, typename ValueType>
 struct KeyValuePair {
@@ -42,6 +42,15 @@ struct KeyValuePair {
     bool operator!=(const KeyValuePair& other) const {
         return !(*this == other);
     }
+
+    // Compare against a bare key, so an ordered tree of pairs can be searched by key
+    friend bool operator<(const KeyValuePair& kvp, const KeyType& key) {
+        return kvp.key < key;
+    }
+
+    friend bool operator<(const KeyType& key, const KeyValuePair& kvp) {
+        return key < kvp.key;
+    }
 };
 
 // Overload operator<< for KeyValuePair so that it can be printed.
@@ -51,36 +60,180 @@ std::ostream& operator<<(std::ostream& os, const KeyValuePair<KeyType, ValueType
     return os;
 }
 
+// Number of keys getMany hashes and prefetches before it starts resolving them
+const int DICTIONARY_BATCH_SIZE = 16;
+
 /*
-    Dictionary class implementation using an AVL Tree for key-value storage
+    Dictionary class implementation using an open addressing HashTable for key-value storage
     This class provides a dictionary (hash map) structure that maps keys to values.
-    It uses an array of AVL trees to handle collisions and ensure efficient operations.
+    The table grows with the number of entries, so lookups stay close to one probe
+    no matter how many actors or movies are loaded.
+    Records created through emplace are owned by the dictionary and kept in a RecordArena,
+    so they are freed together when the dictionary is destroyed.
+    Once the data is loaded, freeze moves every entry into a read-only PerfectHashTable (one slot per key,
+    no probing). Entries added after that go into the normal hash table until the next freeze.
+    An optional Bloom filter in front of both tables rejects most absent keys without touching either table.
+    Every key is also kept in an ordered index in ascending order, so ranges of keys can be visited in order
+    without copying and sorting the whole dictionary. The index is a BTree by default; any tree of
+    KeyValuePair with the same interface (e.g. AVLTree) can be chosen through the OrderedIndex parameter.
 */
-template <typename KeyType, typename ValueType>
+template <typename KeyType, typename ValueType, typename Hasher = DefaultHasher<KeyType>,
+          typename OrderedIndex = BTree<KeyValuePair<KeyType, ValueType>>>
 class Dictionary {
+public:
+    // Type accepted by lookups (string_view for string keys, so no temporary string is built)
+    typedef typename LookupKey<KeyType>::Type KeyView;
+
 private:
-    AVLTree<KeyValuePair<KeyType, ValueType>>* table[MAX_SIZE];
-    int size;
+    HashTable<KeyType, ValueType*, Hasher> table;                  // Entries added since the last freeze
+    PerfectHashTable<KeyType, ValueType*, Hasher> frozen;          // Entries present at the last freeze (nullptr once removed)
+    int frozenCount;                                                // Number of live entries in frozen
+    RecordArena<ValueType> records;    // Storage for the records created by emplace
+
+    BloomFilter bloom;                  // Optional filter over every key (disabled until enableBloomFilter)
+    double bloomFalsePositiveRate;      // Target rate the filter is sized for, kept for rebuilds
+    mutable BloomFilterStats bloomStats;
+
+    OrderedIndex orderedIndex;    // Every entry, ordered by key
+
+    // Rebuilds the Bloom filter from the current keys, sized for at least expectedKeys
+    void rebuildBloomFilter(int expectedKeys);
 
-    unsigned long hash(const KeyType& key) const;
+    // Returns the frozen slot holding the key, or nullptr if the key was not frozen
+    ValueType** findFrozen(KeyView key) const;
+
+    // Looks a key up in the frozen table and then the hash table, using a hash computed earlier
+    ValueType* getWithHash(KeyView key, size_t hashValue) const;
+
+    // Returns true if the key is in the dictionary
+    bool contains(KeyView key) const;
+
+    // Adds an entry to the frozen slot of its key if it has one, otherwise to the table (key must not be present)
+    void insertEntry(const KeyType& key, ValueType* value, bool addToOrderedIndex = true);
 
 public:
     Dictionary();
     virtual ~Dictionary();  // Make the destructor virtual for polymorphism
 
     // Basic operations
-    bool add(const KeyType& key, ValueType* value);
-    bool remove(const KeyType& key);
-    ValueType* get(const KeyType& key) const;
+    bool add(const KeyType& key, ValueType* value);    // The caller keeps ownership of value
+
+    // Constructs a record owned by the dictionary, returns nullptr if the key already exists
+    template <typename... Args>
+    ValueType* emplace(const KeyType& key, Args&&... args);
+
+    // Makes room for at least n entries without further resizing
+    void reserve(int n);
+
+    // Adds many records at once (sorted by key first), returns the keys that were rejected as duplicates
+    vector<KeyType> bulkLoad(vector<pair<KeyType, ValueType>>& rows);
+
+    bool remove(KeyView key);
+    ValueType* get(KeyView key) const;
+
+    // Looks up a batch of keys, overlapping their memory accesses; out[i] is the value of keys[i] or nullptr
+    void getMany(const vector<KeyType>& keys, vector<ValueType*>& out) const;
     bool isEmpty() const;
     int getSize() const;
     void print() const;
 
-    // Returns a vector of ValueType* from all buckets (existing method)
+    // Returns group occupancy and probe length statistics of the hash table holding entries added since the last freeze
+    HashTableStats getStats() const;
+
+    // Moves every entry into a read-only perfect hash table, returns false if it could not be built
+    bool freeze();
+
+    // Returns the bucket sizes and displacements of the frozen table
+    PerfectHashStats getFrozenStats() const { return frozen.getStats(); }
+
+    // Returns the number of entries held in the frozen table
+    int getFrozenSize() const { return frozenCount; }
+
+    // Puts a Bloom filter in front of lookups, sized for expectedKeys (0 = current size) at the given false positive rate
+    void enableBloomFilter(double falsePositiveRate, int expectedKeys = 0);
+
+    // Returns the Bloom filter's counters (all zero if the filter is not enabled)
+    BloomFilterStats getBloomStats() const;
+
+    // Returns a vector of ValueType* from all entries (copies every pointer, prefer forEach or iterators for scans)
     vector<ValueType*> getAllItems() const;
 
-    // Returns a vector of Node pointers (each containing both key and value)
-    vector<KeyValuePair<KeyType, ValueType>*> getAllNodes() const;
+    // Iterates over the entries in place (each entry has a key and a value pointer), in no particular order.
+    // The frozen entries come first, then the entries added since the last freeze
+    class const_iterator {
+    private:
+        typedef typename HashTable<KeyType, ValueType*, Hasher>::const_iterator TableIterator;
+
+        const Dictionary* owner;
+        int frozenSlot;             // Current slot of the frozen table (frozen.size() once past it)
+        TableIterator tableIt;      // Current entry of the table, used once the frozen slots are done
+
+        // Moves forward past frozen slots whose entry was removed
+        void skipRemoved() {
+            while (frozenSlot < owner->frozen.size() && !owner->frozen.entryAt(frozenSlot).value)
+                frozenSlot++;
+        }
+
+    public:
+        typedef forward_iterator_tag iterator_category;
+        typedef typename HashTable<KeyType, ValueType*, Hasher>::Entry value_type;
+        typedef ptrdiff_t difference_type;
+        typedef const value_type* pointer;
+        typedef const value_type& reference;
+
+        const_iterator(const Dictionary* owner, int frozenSlot, TableIterator tableIt)
+            : owner(owner), frozenSlot(frozenSlot), tableIt(tableIt) {
+            skipRemoved();
+        }
+
+        reference operator*() const {
+            return frozenSlot < owner->frozen.size() ? owner->frozen.entryAt(frozenSlot) : *tableIt;
+        }
+        pointer operator->() const { return &**this; }
+
+        const_iterator& operator++() {
+            if (frozenSlot < owner->frozen.size()) {
+                frozenSlot++;
+                skipRemoved();
+            }
+            else {
+                ++tableIt;
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator old = *this;
+            ++(*this);
+            return old;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return frozenSlot == other.frozenSlot && tableIt == other.tableIt;
+        }
+
+        bool operator!=(const const_iterator& other) const {
+            return !(*this == other);
+        }
+    };
+
+    const_iterator begin() const { return const_iterator(this, 0, table.begin()); }
+    const_iterator end() const { return const_iterator(this, frozen.size(), table.end()); }
+
+    // Calls visit(value) for every value in the dictionary without copying anything
+    template <typename Visitor>
+    void forEach(Visitor visit) const;
+
+    // Calls visit(value) for every key from low to high (both included), in ascending key order
+    template <typename Visitor>
+    void forEachInRange(const KeyType& low, const KeyType& high, Visitor visit) const;
+
+    // Calls visit(value) for at most limit keys, in ascending order, starting at the first key not less than start
+    template <typename Visitor>
+    void forEachFrom(const KeyType& start, int limit, Visitor visit) const;
+
+    // Returns the value of the smallest key not less than key, or nullptr if there is none
+    ValueType* lowerBound(const KeyType& key) const;
 
     bool loadFromCSV(const string& fileName, bool isActor);
 
@@ -88,3 +241,95 @@ public:
     bool patchCSV(const string& fileName, bool isActor);
 };
 
+/*
+    Constructs a new record in the dictionary
+
+    This function checks the key first and only then constructs the record in the dictionary's arena,
+    so a duplicate key never uses up any storage. The record stays valid until the dictionary is destroyed,
+    even if its key is removed later.
+
+    Parameter - key: The key to be inserted
+    Parameter - args: The arguments passed to the record's constructor
+    Return - A pointer to the new record if successful, nullptr if the key already exists
+*/
+template <typename KeyType, typename ValueType, typename Hasher, typename OrderedIndex>
+template <typename... Args>
+ValueType* Dictionary<KeyType, ValueType, Hasher, OrderedIndex>::emplace(const KeyType& key, Args&&... args) {
+    if (contains(key)) {
+        cerr << "Error: Duplicate key detected: " << key << endl;
+        return nullptr;
+    }
+
+    ValueType* value = records.create(std::forward<Args>(args)...);
+    insertEntry(key, value);
+    return value;
+}
+
+/*
+    Visits every value stored in the dictionary
+
+    This function walks the frozen table and the hash table once and calls the visitor with each value pointer,
+    without building a vector of the entries first.
+
+    Parameter - visit: A callable taking a ValueType*
+    Return - None
+*/
+template <typename KeyType, typename ValueType, typename Hasher, typename OrderedIndex>
+template <typename Visitor>
+void Dictionary<KeyType, ValueType, Hasher, OrderedIndex>::forEach(Visitor visit) const {
+    for (int slot = 0; slot < frozen.size(); slot++) {
+        ValueType* value = frozen.entryAt(slot).value;
+        if (value)
+            visit(value);
+    }
+    table.forEach([&visit](const typename HashTable<KeyType, ValueType*, Hasher>::Entry& entry) {
+        visit(entry.value);
+    });
+}
+
+/*
+    Visits the values of a range of keys in ascending key order
+
+    This function uses the ordered index, so it costs O(log n + k) for k visited keys.
+
+    Parameter - low: The smallest key to visit
+    Parameter - high: The largest key to visit
+    Parameter - visit: A callable taking a ValueType*
+    Return - None
+*/
+template <typename KeyType, typename ValueType, typename Hasher, typename OrderedIndex>
+template <typename Visitor>
+void Dictionary<KeyType, ValueType, Hasher, OrderedIndex>::forEachInRange(const KeyType& low, const KeyType& high, Visitor visit) const {
+    orderedIndex.visitFrom(low,
+        [&high, &visit](const KeyValuePair<KeyType, ValueType>& entry) {
+            if (high < entry.key)
+                return false;
+            visit(entry.value);
+            return true;
+        });
+}
+
+/*
+    Visits the values of a number of keys in ascending key order
+
+    This is meant for listing the dictionary one page at a time: pass the key after the last one shown
+    as the start of the next page.
+
+    Parameter - start: The smallest key to visit
+    Parameter - limit: The largest number of keys to visit
+    Parameter - visit: A callable taking a ValueType*
+    Return - None
+*/
+template <typename KeyType, typename ValueType, typename Hasher, typename OrderedIndex>
+template <typename Visitor>
+void Dictionary<KeyType, ValueType, Hasher, OrderedIndex>::forEachFrom(const KeyType& start, int limit, Visitor visit) const {
+    if (limit <= 0)
+        return;
+
+    int visited = 0;
+    orderedIndex.visitFrom(start,
+        [limit, &visited, &visit](const KeyValuePair<KeyType, ValueType>& entry) {
+            visit(entry.value);
+            return ++visited < limit;
+        });
+}
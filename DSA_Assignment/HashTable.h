@@ -0,0 +1,850 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <algorithm>
+#include <iterator>
+#include <cstring>
+
+// SSE2 is used for the control byte scans when the compiler targets it.
+// Define HASH_TABLE_NO_SIMD to force the portable scalar version.
+#if !defined(HASH_TABLE_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define HASH_TABLE_USE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+using namespace std;
+
+// Number of slots in a newly created table (must be a power of two, at least one group)
+const int HASH_TABLE_INITIAL_CAPACITY = 16;
+
+// Number of slots moved from the old table to the new table on every insert or erase during a resize
+const int HASH_TABLE_MIGRATION_STEP = 8;
+
+// Number of control bytes compared at once. A table is an array of groups of this many slots
+const int HASH_TABLE_GROUP_SIZE = 16;
+
+// Control byte values. A full slot stores the low 7 bits of its key's hash (0x00 - 0x7F),
+// so both special values have the high bit set.
+const unsigned char CONTROL_EMPTY = 0x80;
+const unsigned char CONTROL_DELETED = 0xFE;
+
+/*
+    Returns the index of the lowest set bit of a non-zero mask
+
+    Parameter - mask: A non-zero bit mask
+    Return - The index of its lowest set bit
+*/
+inline int lowestBitIndex(unsigned int mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+/*
+    Compares every control byte of a group against one value
+
+    Parameter - group: Pointer to the first control byte of the group
+    Parameter - value: The control byte to look for
+    Return - A bit mask with bit i set if control byte i equals the value
+*/
+inline unsigned int matchControl(const unsigned char* group, unsigned char value) {
+#ifdef HASH_TABLE_USE_SSE2
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+    __m128i match = _mm_cmpeq_epi8(bytes, _mm_set1_epi8(static_cast<char>(value)));
+    return static_cast<unsigned int>(_mm_movemask_epi8(match));
+#else
+    unsigned int mask = 0;
+    for (int i = 0; i < HASH_TABLE_GROUP_SIZE; i++) {
+        if (group[i] == value)
+            mask |= 1u << i;
+    }
+    return mask;
+#endif
+}
+
+/*
+    Finds the slots of a group that are empty or deleted
+
+    Parameter - group: Pointer to the first control byte of the group
+    Return - A bit mask with bit i set if slot i does not hold an entry
+*/
+inline unsigned int matchFree(const unsigned char* group) {
+#ifdef HASH_TABLE_USE_SSE2
+    // Free control bytes are exactly the ones with the high bit set
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+    return static_cast<unsigned int>(_mm_movemask_epi8(bytes));
+#else
+    unsigned int mask = 0;
+    for (int i = 0; i < HASH_TABLE_GROUP_SIZE; i++) {
+        if (group[i] & 0x80)
+            mask |= 1u << i;
+    }
+    return mask;
+#endif
+}
+
+/*
+    Asks the CPU to start loading a cache line that will be read soon
+
+    This is only a hint; it does nothing on compilers where no prefetch instruction is available.
+
+    Parameter - address: Any address inside the cache line to load
+*/
+inline void prefetchRead(const void* address) {
+#if defined(HASH_TABLE_USE_SSE2)
+    _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#elif defined(__GNUC__)
+    __builtin_prefetch(address);
+#else
+    (void)address;
+#endif
+}
+
+/*
+    Multiplies two 64-bit values and folds the 128-bit product back to 64 bits
+
+    This is the mixing step of the string hash: every bit of the result depends on every bit of both inputs.
+
+    Parameter - a: The first value
+    Parameter - b: The second value
+    Return - The low and high halves of a * b combined with xor
+*/
+inline unsigned long long hashMultiplyFold(unsigned long long a, unsigned long long b) {
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+    return static_cast<unsigned long long>(product) ^ static_cast<unsigned long long>(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long long high;
+    unsigned long long low = _umul128(a, b, &high);
+    return low ^ high;
+#else
+    unsigned long long aLow = a & 0xFFFFFFFFULL, aHigh = a >> 32;
+    unsigned long long bLow = b & 0xFFFFFFFFULL, bHigh = b >> 32;
+    unsigned long long lowLow = aLow * bLow, lowHigh = aLow * bHigh;
+    unsigned long long highLow = aHigh * bLow, highHigh = aHigh * bHigh;
+    unsigned long long middle = (lowLow >> 32) + (lowHigh & 0xFFFFFFFFULL) + (highLow & 0xFFFFFFFFULL);
+    unsigned long long low = (lowLow & 0xFFFFFFFFULL) | (middle << 32);
+    unsigned long long high = highHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+    return low ^ high;
+#endif
+}
+
+// Reads 8 or 4 bytes from an unaligned address (in the machine's byte order)
+inline unsigned long long hashRead64(const char* p) {
+    unsigned long long value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline unsigned long long hashRead32(const char* p) {
+    unsigned int value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+/*
+    Computes the hash value of a string key
+
+    This function is a wyhash-style hash: it reads the key 16 bytes at a time and mixes each block
+    with a 64x64 -> 128 bit multiply. Keys of up to 16 bytes (most names and titles) are read with at most
+    four overlapping loads and no loop. Both the tag bits and the group bits depend on every byte of the key.
+
+    Parameter - key: The key to be hashed
+    Return - The full-width hash value of the key
+*/
+inline size_t hashKey(string_view key) {
+    const unsigned long long secret0 = 0xa0761d6478bd642fULL;
+    const unsigned long long secret1 = 0xe7037ed1a0b428dbULL;
+    const unsigned long long secret2 = 0x8ebc6af09c88c6e3ULL;
+
+    const char* p = key.data();
+    size_t length = key.size();
+    unsigned long long seed = secret0;
+    unsigned long long a, b;
+
+    if (length <= 16) {
+        if (length >= 4) {
+            size_t offset = (length >> 3) << 2;     // 0 for 4-7 bytes, 4 for 8-16 bytes
+            a = (hashRead32(p) << 32) | hashRead32(p + offset);
+            b = (hashRead32(p + length - 4) << 32) | hashRead32(p + length - 4 - offset);
+        }
+        else if (length > 0) {
+            a = (static_cast<unsigned long long>(static_cast<unsigned char>(p[0])) << 16)
+                | (static_cast<unsigned long long>(static_cast<unsigned char>(p[length >> 1])) << 8)
+                | static_cast<unsigned char>(p[length - 1]);
+            b = 0;
+        }
+        else {
+            a = b = 0;
+        }
+    }
+    else {
+        size_t remaining = length;
+        while (remaining > 16) {
+            seed = hashMultiplyFold(hashRead64(p) ^ secret1, hashRead64(p + 8) ^ seed);
+            p += 16;
+            remaining -= 16;
+        }
+        // The last block may overlap the previous one
+        a = hashRead64(p + remaining - 16);
+        b = hashRead64(p + remaining - 8);
+    }
+
+    return static_cast<size_t>(hashMultiplyFold(secret1 ^ length, hashMultiplyFold(a ^ secret1, b ^ seed ^ secret2)));
+}
+
+/*
+    Computes the hash value of an integer key
+
+    This function mixes the bits of the integer (splitmix64 finalizer) so that IDs that are
+    close together still land in different groups. It is a few multiplies with no loop or branch.
+
+    Parameter - key: The key to be hashed
+    Return - The full-width hash value of the key
+*/
+inline size_t hashKey(unsigned long long key) {
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ULL;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebULL;
+    key ^= key >> 31;
+    return static_cast<size_t>(key);
+}
+
+inline size_t hashKey(unsigned int key) {
+    return hashKey(static_cast<unsigned long long>(key));
+}
+
+/*
+    Type used to look a key up in a HashTable
+
+    Lookups take this type instead of the key type, so string keys can be searched for with a
+    string_view (or a const char*, or a string) without building a temporary string.
+*/
+template <typename KeyType>
+struct LookupKey {
+    typedef const KeyType& Type;
+};
+
+template <>
+struct LookupKey<string> {
+    typedef string_view Type;
+};
+
+// Integer keys are passed by value
+template <>
+struct LookupKey<unsigned int> {
+    typedef unsigned int Type;
+};
+
+template <>
+struct LookupKey<unsigned long long> {
+    typedef unsigned long long Type;
+};
+
+/*
+    Default hasher used by HashTable
+
+    This hasher calls the hashKey overload for the key type (string or integer).
+    A different hasher can be passed as the third template argument of HashTable, e.g. to compare
+    hash functions with getStats. It must take a LookupKey<KeyType>::Type and return a size_t
+    whose bits are all well mixed, since both the low bits (tag) and the higher bits (group) are used.
+*/
+template <typename KeyType>
+struct DefaultHasher {
+    size_t operator()(typename LookupKey<KeyType>::Type key) const {
+        return hashKey(key);
+    }
+};
+
+/*
+    Statistics about how the entries of a HashTable are spread over its groups
+
+    Probe length is the number of groups a lookup of an entry visits before it reaches the entry
+    (1 means the entry is in its home group).
+*/
+struct HashTableStats {
+    int size;                       // Number of entries
+    int capacity;                   // Number of slots (both tables while a resize is in progress)
+    int groups;                     // Number of groups
+    int tombstones;                 // Number of deleted slots
+    vector<int> groupOccupancy;     // groupOccupancy[k] is the number of groups holding k entries (k = 0 to 16)
+    int maxProbeLength;             // Longest probe length of any entry
+    double averageProbeLength;      // Average probe length over all entries
+
+    HashTableStats() : size(0), capacity(0), groups(0), tombstones(0),
+        groupOccupancy(HASH_TABLE_GROUP_SIZE + 1, 0), maxProbeLength(0), averageProbeLength(0.0) {}
+};
+
+/*
+    HashTable class implementation using open addressing with control bytes (Swiss table layout)
+
+    All entries live in one flat array of slots. Next to it is an array of one-byte control values
+    holding a 7-bit tag of each entry's hash. A lookup loads a group of 16 control bytes and
+    compares them against the key's tag in one SSE2 instruction (or a scalar loop), and only
+    compares full keys for the slots whose tag matches. Most hits and misses are settled by the
+    first group. The table doubles itself when it gets more than 3/4 full. Resizing is incremental:
+    the old table is kept and drained a few slots at a time on every insert and erase,
+    so no single insert has to move every entry at once.
+*/
+template <typename KeyType, typename MappedType, typename Hasher = DefaultHasher<KeyType>>
+class HashTable {
+public:
+    // Entry stored in a slot
+    struct Entry {
+        KeyType key;
+        MappedType value;
+    };
+
+    typedef typename LookupKey<KeyType>::Type KeyView;
+
+private:
+    // A single flat slot array with its control bytes
+    struct Table {
+        vector<Entry> slots;
+        vector<unsigned char> control;
+        int capacity;   // Number of slots (power of two, multiple of the group size)
+        int used;       // Number of full + deleted slots
+
+        Table() : capacity(0), used(0) {}
+    };
+
+    Table current;      // Table receiving all new inserts
+    Table previous;     // Old table being drained during an incremental resize
+    int migrateIndex;   // Next slot of the old table to move
+    int count;          // Number of entries in both tables
+    Hasher hasher;
+
+    size_t hash(KeyView key) const;
+
+    // Low 7 bits of the hash, stored in the control byte of a full slot
+    static unsigned char tagOf(size_t hashValue) { return static_cast<unsigned char>(hashValue & 0x7F); }
+
+    // Returns the slot index of the key in the given table, or -1 if it is not there
+    int findSlot(const Table& table, KeyView key, size_t hashValue) const;
+
+    // Adds the group occupancy and probe lengths of one table to the statistics
+    void collectStats(const Table& table, HashTableStats& stats, long long& totalProbes) const;
+
+    // Places an entry in the first free slot of its probe sequence (key must not be present)
+    void place(Table& table, KeyType&& key, MappedType&& value, size_t hashValue);
+
+    // Allocates a new table and starts draining the current one into it
+    void startResize();
+
+    // Moves the next HASH_TABLE_MIGRATION_STEP slots of the old table into the current one
+    void migrateStep();
+
+    // Moves every remaining slot of the old table into the current one
+    void finishMigration();
+
+    bool isMigrating() const { return previous.capacity > 0; }
+
+    static void allocate(Table& table, int capacity);
+
+public:
+    HashTable();
+
+    // Basic operations
+    bool insert(const KeyType& key, const MappedType& value);
+    bool erase(KeyView key);
+    MappedType* find(KeyView key);
+    const MappedType* find(KeyView key) const;
+    void clear();
+
+    // Returns statistics about group occupancy and probe lengths
+    HashTableStats getStats() const;
+
+    // Split lookup for batches: hash every key, prefetch their home groups, then find them with the saved hash
+    size_t hashOf(KeyView key) const { return hash(key); }
+    void prefetch(size_t hashValue) const;
+    const MappedType* findWithHash(KeyView key, size_t hashValue) const;
+
+    // Makes room for at least n entries, so inserting up to n entries never triggers a resize
+    void reserve(int n);
+
+    int size() const { return count; }
+    bool isEmpty() const { return count == 0; }
+
+    // Total number of slots currently allocated (both tables while a resize is in progress)
+    int capacity() const { return current.capacity + previous.capacity; }
+
+    // Calls visit(entry) for every entry in the table
+    template <typename Visitor>
+    void forEach(Visitor visit) const;
+
+    // Forward iterator over the entries, reading them in place in the slot arrays
+    class const_iterator {
+    private:
+        const HashTable* owner;
+        int tableIndex;     // 0 = current table, 1 = old table, 2 = end
+        int slot;
+
+        const Table& table() const { return tableIndex == 0 ? owner->current : owner->previous; }
+
+        // Moves forward to the next full slot (or to the end)
+        void skipFree() {
+            while (tableIndex < 2) {
+                const Table& t = table();
+                while (slot < t.capacity && (t.control[slot] & 0x80))
+                    slot++;
+                if (slot < t.capacity)
+                    return;
+                tableIndex++;
+                slot = 0;
+            }
+        }
+
+    public:
+        typedef forward_iterator_tag iterator_category;
+        typedef Entry value_type;
+        typedef ptrdiff_t difference_type;
+        typedef const Entry* pointer;
+        typedef const Entry& reference;
+
+        const_iterator(const HashTable* owner, int tableIndex, int slot)
+            : owner(owner), tableIndex(tableIndex), slot(slot) {
+            skipFree();
+        }
+
+        const Entry& operator*() const { return table().slots[slot]; }
+        const Entry* operator->() const { return &table().slots[slot]; }
+
+        const_iterator& operator++() {
+            slot++;
+            skipFree();
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator old = *this;
+            ++(*this);
+            return old;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return tableIndex == other.tableIndex && slot == other.slot;
+        }
+
+        bool operator!=(const const_iterator& other) const {
+            return !(*this == other);
+        }
+    };
+
+    const_iterator begin() const { return const_iterator(this, 0, 0); }
+    const_iterator end() const { return const_iterator(this, 2, 0); }
+};
+
+
+// Constructor for HashTable
+template <typename KeyType, typename MappedType, typename Hasher>
+HashTable<KeyType, MappedType, Hasher>::HashTable() : migrateIndex(0), count(0) {
+    allocate(current, HASH_TABLE_INITIAL_CAPACITY);
+}
+
+/*
+    Allocates an empty slot array
+
+    Parameter - table: The table to (re)allocate
+    Parameter - capacity: The number of slots, must be a power of two (0 releases the table)
+*/
+template <typename KeyType, typename MappedType, typename Hasher>
+void HashTable<KeyType, MappedType, Hasher>::allocate(Table& table, int capacity) {
+    vector<Entry>(capacity).swap(table.slots);
+    vector<unsigned char>(capacity, CONTROL_EMPTY).swap(table.control);
+    table.capacity = capacity;
+    table.used = 0;
+}
+
+/*
+    Computes the hash value for a given key
+
+    This function calls the table's hasher (DefaultHasher unless another one was given).
+
+    Parameter - key: The key to be hashed
+    Return - The full-width hash value of the key
+*/
+template <typename KeyType, typename MappedType, typename Hasher>
+size_t HashTable<KeyType, MappedType, Hasher>::hash(KeyView key) const {
+    return hasher(key);
+}
+
+/*
+    Finds the slot holding a key in one table
+
+    This function visits the groups of the key's probe sequence (triangular steps over the groups).
+    In each group it checks only the slots whose control byte matches the key's tag, and stops
+    at the first group that still has an empty slot, since the key would have been placed there.
+
+    Parameter - table: The table to search
+    Parameter - key: The key to search for
+    Parameter - hashValue: The hash of the key
+    Return - The slot index if found, otherwise -1
+*/
+template <typename KeyType, typename MappedType, typename Hasher>
+int HashTable<KeyType, MappedType, Hasher>::findSlot(const Table& table, KeyView key, size_t hashValue) const {
+    int groupMask = table.capacity / HASH_TABLE_GROUP_SIZE - 1;
+    int group = static_cast<int>((hashValue >> 7) & groupMask);
+    unsigned char tag = tagOf(hashValue);
+
+    for (int probes = 0; probes <= groupMask; probes++) {
+        int base = group * HASH_TABLE_GROUP_SIZE;
+        const unsigned char* control = &table.control[base];
+
+        unsigned int candidates = matchControl(control, tag);
+        while (candidates != 0) {
+            int index = base + lowestBitIndex(candidates);
+            if (table.slots[index].key == key)
+                return index;
+            candidates &= candidates - 1;
+        }
+        if (matchControl(control, CONTROL_EMPTY) != 0)
+            return -1;
+
+        group = (group + probes + 1) & groupMask;
+    }
+    return -1;
+}
+
+/*
+    Places an entry into a table
+
+    This function stores the entry in the first empty or deleted slot of the key's probe sequence.
+    The caller must make sure the key is not already in the table and that the table has a free slot.
+
+    Parameter - table: The table to insert into
+    Parameter - key: The key of the entry
+    Parameter - value: The value of the entry
+    Parameter - hashValue: The hash of the key
+*/
+template <typename KeyType, typename MappedType, typename Hasher>
+void HashTable<KeyType, MappedType, Hasher>::place(Table& table, KeyType&& key, MappedType&& value, size_t hashValue) {
+    int groupMask = table.capacity / HASH_TABLE_GROUP_SIZE - 1;
+    int group = static_cast<int>((hashValue >> 7) & groupMask);
+
+    unsigned int freeSlots = 0;
+    for (int probes = 0; ; probes++) {
+        freeSlots = matchFree(&table.control[group * HASH_TABLE_GROUP_SIZE]);
+        if (freeSlots != 0)
+            break;
+        group = (group + probes + 1) & groupMask;
+    }
+
+    int index = group * HASH_TABLE_GROUP_SIZE + lowestBitIndex(freeSlots);
+    if (table.control[index] == CONTROL_EMPTY)
+        table.used++;
+    table.control[index] = tagOf(hashValue);
+    table.slots[index].key = move(key);
+    table.slots[index].value = move(value);
+}
+
+/*
+    Starts an incremental resize
+
+    This function moves the current table aside and allocates a new one. The new table is large
+    enough to be at most half full once every entry has been moved. If most of the used slots are
+    tombstones the table is rebuilt at the same size, which clears them out.
+*/
+template <typename KeyType, typename MappedType, typename Hasher>
+void HashTable<KeyType, MappedType, Hasher>::startResize() {
+    if (isMigrating())
+        finishMigration();
+
+    int newCapacity = current.capacity;
+    while ((count + 1) * 2 > newCapacity) {
+        newCapacity *= 2;
+    }
+
+    previous.slots.swap(current.slots);
+    previous.control.swap(current.control);
+    previous.capacity = current.capacity;
+    previous.used = current.used;
+    allocate(current, newCapacity);
+    migrateIndex = 0;
+}
+
+/*
+    Moves a few slots of the old table into the current table
+
+    Moved slots are marked as deleted in the old table rather than empty, so keys further along
+    the same probe sequence can still be found there until they are moved as well.
+    Once every slot has been moved the old table is released.
+*/
+template <typename KeyType, typename MappedType, typename Hasher>
+void HashTable<KeyType, MappedType, Hasher>::migrateStep() {
+    if (!isMigrating())
+        return;
+
+    int end = min(migrateIndex + HASH_TABLE_MIGRATION_STEP, previous.capacity);
+    for (; migrateIndex < end; migrateIndex++) {
+        if (!(previous.control[migrateIndex] & 0x80)) {
+            Entry& entry = previous.slots[migrateIndex];
+            size_t hashValue = hash(entry.key);
+            place(current, move(entry.key), move(entry.value), hashValue);
+            previous.control[migrateIndex] = CONTROL_DELETED;
+        }
+    }
+
+    if (migrateIndex == previous.capacity) {
+        allocate(previous, 0);
+        migrateIndex = 0;
+    }
+}
+
+// Moves every remaining slot of the old table into the current table
+template <typename KeyType, typename MappedType, typename Hasher>
+void HashTable<KeyType, MappedType, Hasher>::finishMigration() {
+    while (isMigrating()) {
+        migrateStep();
+    }
+}
+
+/*
+    Inserts a new key-value entry into the table
+
+    This function checks both tables for the key first, then advances any resize in progress
+    and starts a new one if the current table would go over 3/4 full.
+
+    Parameter - key: The key to be inserted
+    Parameter - value: The value associated with the key
+    Return - True if insertion is successful, false if the key already exists
+*/
+template <typename KeyType, typename MappedType, typename Hasher>
+bool HashTable<KeyType, MappedType, Hasher>::insert(const KeyType& key, const MappedType& value) {
+    size_t hashValue = hash(key);
+    if (findSlot(current, key, hashValue) != -1)
+        return false;
+    if (isMigrating() && findSlot(previous, key, hashValue) != -1)
+        return false;
+
+    migrateStep();
+    if ((current.used + 1) * 4 > current.capacity * 3)
+        startResize();
+
+    KeyType keyCopy = key;
+    MappedType valueCopy = value;
+    place(current, move(keyCopy), move(valueCopy), hashValue);
+    count++;
+    return true;
+}
+
+/*
+    Removes an entry from the table
+
+    This function frees the slot holding the key in whichever table holds it. If the slot's group
+    still has an empty slot no probe sequence can pass through the group, so the slot can be made
+    empty again; otherwise it becomes a tombstone.
+
+    Parameter - key: The key of the entry to be removed
+    Return - True if the key was removed, false if the key was not found
+*/
+template <typename KeyType, typename MappedType, typename Hasher>
+bool HashTable<KeyType, MappedType, Hasher>::erase(KeyView key) {
+    size_t hashValue = hash(key);
+    Table* table = &current;
+    int index = findSlot(current, key, hashValue);
+    if (index == -1 && isMigrating()) {
+        table = &previous;
+        index = findSlot(previous, key, hashValue);
+    }
+    if (index == -1)
+        return false;
+
+    int base = index - index % HASH_TABLE_GROUP_SIZE;
+    if (matchControl(&table->control[base], CONTROL_EMPTY) != 0) {
+        table->control[index] = CONTROL_EMPTY;
+        table->used--;
+    }
+    else {
+        table->control[index] = CONTROL_DELETED;
+    }
+    table->slots[index] = Entry();
+    count--;
+    migrateStep();
+    return true;
+}
+
+/*
+    Retrieves the value associated with a given key
+
+    Parameter - key: The key whose value is to be retrieved
+    Return - A pointer to the stored value if found, otherwise nullptr
+*/
+template <typename KeyType, typename MappedType, typename Hasher>
+MappedType* HashTable<KeyType, MappedType, Hasher>::find(KeyView key) {
+    const HashTable& self = *this;
+    return const_cast<MappedType*>(self.find(key));
+}
+
+template <typename KeyType, typename MappedType, typename Hasher>
+const MappedType* HashTable<KeyType, MappedType, Hasher>::find(KeyView key) const {
+    return findWithHash(key, hash(key));
+}
+
+/*
+    Retrieves the value associated with a key whose hash is already known
+
+    Parameter - key: The key whose value is to be retrieved
+    Parameter - hashValue: The hash of the key (from hashOf)
+    Return - A pointer to the stored value if found, otherwise nullptr
+*/
+template <typename KeyType, typename MappedType, typename Hasher>
+const MappedType* HashTable<KeyType, MappedType, Hasher>::findWithHash(KeyView key, size_t hashValue) const {
+    int index = findSlot(current, key, hashValue);
+    if (index != -1)
+        return &current.slots[index].value;
+    if (isMigrating()) {
+        index = findSlot(previous, key, hashValue);
+        if (index != -1)
+            return &previous.slots[index].value;
+    }
+    return nullptr;
+}
+
+/*
+    Starts loading the home group of a hash into the cache
+
+    This function prefetches the control bytes and the first slots of the group a lookup of the hash
+    visits first, so a later findWithHash does not have to wait for memory.
+
+    Parameter - hashValue: The hash of the key that will be looked up
+*/
+template <typename KeyType, typename MappedType, typename Hasher>
+void HashTable<KeyType, MappedType, Hasher>::prefetch(size_t hashValue) const {
+    int groupMask = current.capacity / HASH_TABLE_GROUP_SIZE - 1;
+    int base = static_cast<int>((hashValue >> 7) & groupMask) * HASH_TABLE_GROUP_SIZE;
+    prefetchRead(&current.control[base]);
+    prefetchRead(&current.slots[base]);
+}
+
+// Removes every entry and shrinks the table back to its initial capacity
+template <typename KeyType, typename MappedType, typename Hasher>
+void HashTable<KeyType, MappedType, Hasher>::clear() {
+    allocate(previous, 0);
+    allocate(current, HASH_TABLE_INITIAL_CAPACITY);
+    migrateIndex = 0;
+    count = 0;
+}
+
+/*
+    Reserves room for a number of entries
+
+    This function grows the table up front, so a bulk load of n entries does not go through
+    several incremental resizes. Every entry is moved into the new table right away
+    (the resize is not spread over later inserts). Nothing happens if the table is already big enough.
+
+    Parameter - n: The number of entries the table should be able to hold
+*/
+template <typename KeyType, typename MappedType, typename Hasher>
+void HashTable<KeyType, MappedType, Hasher>::reserve(int n) {
+    finishMigration();
+    if (n * 4 <= current.capacity * 3)
+        return;
+
+    int newCapacity = current.capacity;
+    while (n * 4 > newCapacity * 3) {
+        newCapacity *= 2;
+    }
+
+    previous.slots.swap(current.slots);
+    previous.control.swap(current.control);
+    previous.capacity = current.capacity;
+    previous.used = current.used;
+    allocate(current, newCapacity);
+    migrateIndex = 0;
+    finishMigration();
+}
+
+/*
+    Visits every entry in the table
+
+    This function calls the visitor once for every full slot, first in the current table
+    and then in the old table if a resize is in progress. The order is unspecified.
+
+    Parameter - visit: A callable taking a const Entry&
+*/
+template <typename KeyType, typename MappedType, typename Hasher>
+template <typename Visitor>
+void HashTable<KeyType, MappedType, Hasher>::forEach(Visitor visit) const {
+    for (int i = 0; i < current.capacity; i++) {
+        if (!(current.control[i] & 0x80))
+            visit(current.slots[i]);
+    }
+    for (int i = 0; i < previous.capacity; i++) {
+        if (!(previous.control[i] & 0x80))
+            visit(previous.slots[i]);
+    }
+}
+
+/*
+    Adds the statistics of one table
+
+    This function counts the entries and tombstones of every group, and for every entry replays
+    its probe sequence from its home group to find how many groups a lookup visits.
+
+    Parameter - table: The table to measure
+    Parameter - stats: The statistics to add to
+    Parameter - totalProbes: Running sum of probe lengths, used for the average
+*/
+template <typename KeyType, typename MappedType, typename Hasher>
+void HashTable<KeyType, MappedType, Hasher>::collectStats(const Table& table, HashTableStats& stats, long long& totalProbes) const {
+    int groupCount = table.capacity / HASH_TABLE_GROUP_SIZE;
+    int groupMask = groupCount - 1;
+    stats.capacity += table.capacity;
+    stats.groups += groupCount;
+
+    for (int group = 0; group < groupCount; group++) {
+        int full = 0;
+        for (int i = group * HASH_TABLE_GROUP_SIZE; i < (group + 1) * HASH_TABLE_GROUP_SIZE; i++) {
+            if (table.control[i] == CONTROL_DELETED) {
+                stats.tombstones++;
+                continue;
+            }
+            if (table.control[i] & 0x80)
+                continue;
+            full++;
+
+            int probe = static_cast<int>((hash(table.slots[i].key) >> 7) & groupMask);
+            int length = 1;
+            while (probe != group) {
+                probe = (probe + length) & groupMask;
+                length++;
+            }
+            totalProbes += length;
+            stats.maxProbeLength = max(stats.maxProbeLength, length);
+        }
+        stats.groupOccupancy[full]++;
+    }
+}
+
+/*
+    Measures how evenly the entries are spread over the table
+
+    This function walks every slot once, so it costs about as much as a full scan.
+    It is meant for checking a hash function against real data, not for use on every operation.
+
+    Return - The group occupancy histogram, tombstone count and probe lengths of the table
+*/
+template <typename KeyType, typename MappedType, typename Hasher>
+HashTableStats HashTable<KeyType, MappedType, Hasher>::getStats() const {
+    HashTableStats stats;
+    long long totalProbes = 0;
+    collectStats(current, stats, totalProbes);
+    if (isMigrating())
+        collectStats(previous, stats, totalProbes);
+
+    stats.size = count;
+    stats.averageProbeLength = count > 0 ? static_cast<double>(totalProbes) / count : 0.0;
+    return stats;
+}
@@ -3,13 +3,16 @@
 #include <string>
 #include <iostream>
 #include <vector>
+
+#include "RecordId.h"
+
 using namespace std;
 
 class Actor; 
 
 class Movie {
 public:
-    string id;
+    RecordId id;
     string title;
     string plot;
     string year;  
@@ -20,7 +23,7 @@ public:
     // Used to make sure if title is quoted it stays quoted from storing back to CSV
     bool titleWasQuoted;
 
-    Movie(string id, string title, string plot, string year, double rating = 0.0, int noOfTimesRated = 0)
+    Movie(RecordId id, string title, string plot, string year, double rating = 0.0, int noOfTimesRated = 0)
         : id(id), title(title), plot(plot), year(year), rating(rating), noOfTimesRated(noOfTimesRated),
         titleWasQuoted(false)
     {
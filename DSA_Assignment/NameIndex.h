@@ -0,0 +1,157 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <string_view>
+
+#include "HashTable.h"
+
+using namespace std;
+
+/*
+    NameIndex class implementation (secondary index from a name to records)
+
+    This class maps a normalized name to every record with that name, so a record can be found
+    by name with one hash lookup instead of scanning the whole Dictionary.
+    Names are normalized before hashing (see normalize), so lookups ignore case, extra spaces
+    and surrounding quotes (movie titles may be stored quoted or unquoted).
+    Several records may share a name, so each name maps to a list of records.
+    The index does not own the records; the caller must keep it in sync when a name changes.
+*/
+template <typename ValueType>
+class NameIndex {
+private:
+    HashTable<string, vector<ValueType*>> index;
+
+public:
+    // Returns the form of a name used as the index key
+    static string normalize(string_view name);
+
+    // Adds a record under the given name
+    void add(string_view name, ValueType* value);
+
+    // Removes a record from under the given name
+    bool remove(string_view name, ValueType* value);
+
+    // Moves a record from its old name to its new name
+    void rename(string_view oldName, string_view newName, ValueType* value);
+
+    // Returns every record with the given name, or nullptr if there are none
+    const vector<ValueType*>* find(string_view name) const;
+
+    // Returns the number of distinct names in the index
+    int size() const { return index.size(); }
+
+    // Returns group occupancy and probe length statistics of the underlying hash table
+    HashTableStats getStats() const { return index.getStats(); }
+};
+
+
+/*
+    Normalizes a name for use as an index key
+
+    This function trims leading and trailing whitespace, removes one pair of surrounding double quotes,
+    collapses runs of whitespace inside the name to a single space and converts ASCII letters to lower case.
+    Non-ASCII bytes (e.g. accented letters in UTF-8) are kept as they are.
+
+    Parameter - name: The name to normalize
+    Return - The normalized name
+*/
+template <typename ValueType>
+string NameIndex<ValueType>::normalize(string_view name) {
+    size_t start = name.find_first_not_of(" \t\r\n");
+    size_t end = name.find_last_not_of(" \t\r\n");
+    name = (start == string_view::npos) ? string_view() : name.substr(start, end - start + 1);
+    if (name.size() >= 2 && name.front() == '"' && name.back() == '"')
+        name = name.substr(1, name.size() - 2);
+
+    string result;
+    result.reserve(name.size());
+    bool pendingSpace = false;
+    for (char c : name) {
+        if (c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+            pendingSpace = !result.empty();
+            continue;
+        }
+        if (pendingSpace) {
+            result.push_back(' ');
+            pendingSpace = false;
+        }
+        if (c >= 'A' && c <= 'Z')
+            c = static_cast<char>(c - 'A' + 'a');
+        result.push_back(c);
+    }
+    return result;
+}
+
+/*
+    Adds a record to the index
+
+    Parameter - name: The name of the record
+    Parameter - value: A pointer to the record
+    Return - None
+*/
+template <typename ValueType>
+void NameIndex<ValueType>::add(string_view name, ValueType* value) {
+    string key = normalize(name);
+    vector<ValueType*>* records = index.find(key);
+    if (records) {
+        records->push_back(value);
+    }
+    else {
+        index.insert(key, vector<ValueType*>(1, value));
+    }
+}
+
+/*
+    Removes a record from the index
+
+    This function removes the record from the list of its name, and removes the name
+    from the index once no record has it any more.
+
+    Parameter - name: The name the record was added under
+    Parameter - value: A pointer to the record
+    Return - True if the record was found and removed, false otherwise
+*/
+template <typename ValueType>
+bool NameIndex<ValueType>::remove(string_view name, ValueType* value) {
+    string key = normalize(name);
+    vector<ValueType*>* records = index.find(key);
+    if (!records)
+        return false;
+
+    for (size_t i = 0; i < records->size(); i++) {
+        if ((*records)[i] == value) {
+            records->erase(records->begin() + i);
+            if (records->empty())
+                index.erase(key);
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+    Updates the index after a record's name has changed
+
+    Parameter - oldName: The name the record was added under
+    Parameter - newName: The new name of the record
+    Parameter - value: A pointer to the record
+    Return - None
+*/
+template <typename ValueType>
+void NameIndex<ValueType>::rename(string_view oldName, string_view newName, ValueType* value) {
+    remove(oldName, value);
+    add(newName, value);
+}
+
+/*
+    Finds every record with a given name
+
+    Parameter - name: The name to look up (case, extra spaces and surrounding quotes are ignored)
+    Return - A pointer to the list of matching records, or nullptr if no record has the name
+*/
+template <typename ValueType>
+const vector<ValueType*>* NameIndex<ValueType>::find(string_view name) const {
+    return index.find(normalize(name));
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <vector>
+#include <new>
+#include <utility>
+
+using namespace std;
+
+#ifndef NODE_POOL_CHUNK_SIZE
+#define NODE_POOL_CHUNK_SIZE 256   // Nodes per chunk
+#endif
+
+/*
+    NodePool class implementation (fixed-size allocator for tree nodes)
+
+    This class hands out memory for objects of one type (e.g. AVLNode<T>) from large chunks.
+    A new node normally takes the next slot of the last chunk (a pointer bump), so nodes created one
+    after another sit next to each other in memory. A destroyed node's slot goes on a free list and is
+    reused by the next create, so a tree that keeps inserting and removing does not grow the pool.
+    releaseAll gives every chunk back at once, which lets a tree that owns its pool be torn down without
+    freeing its nodes one at a time.
+
+    A pool can be owned by one tree or shared by several trees of the same element type.
+*/
+template <typename Node>
+class NodePool {
+private:
+    // A slot holds either a live node or the link to the next free slot
+    union Slot {
+        Slot* next;
+        alignas(Node) unsigned char storage[sizeof(Node)];
+    };
+
+    vector<Slot*> chunks;   // Raw storage, each chunk holds NODE_POOL_CHUNK_SIZE slots
+    Slot* freeList;         // Slots of destroyed nodes, ready to be reused
+    int usedInLastChunk;    // Number of slots handed out from the last chunk
+    int count;              // Number of live nodes
+
+public:
+    NodePool() : freeList(nullptr), usedInLastChunk(NODE_POOL_CHUNK_SIZE), count(0) {}
+    ~NodePool() { releaseAll(); }
+
+    // The pool owns its chunks, so it cannot be copied
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    // Constructs a new node in the pool and returns a pointer to it
+    template <typename... Args>
+    Node* create(Args&&... args);
+
+    // Destroys a node created by this pool and keeps its slot for reuse
+    void destroy(Node* node);
+
+    // Frees every chunk without running any destructor (the nodes must already be destroyed or trivial)
+    void releaseAll();
+
+    // Returns the number of live nodes
+    int size() const { return count; }
+
+    // Returns the number of chunks allocated
+    int getChunkCount() const { return static_cast<int>(chunks.size()); }
+};
+
+
+/*
+    Constructs a new node in the pool
+
+    This function reuses the most recently freed slot if there is one, otherwise it takes the next slot
+    of the last chunk, allocating a new chunk first if the last one is full.
+
+    Parameter - args: The arguments passed to the node's constructor
+    Return - A pointer to the new node (valid until it is destroyed or the pool is released)
+*/
+template <typename Node>
+template <typename... Args>
+Node* NodePool<Node>::create(Args&&... args) {
+    Slot* slot;
+    if (freeList) {
+        slot = freeList;
+        freeList = freeList->next;
+    }
+    else {
+        if (usedInLastChunk == NODE_POOL_CHUNK_SIZE) {
+            chunks.push_back(static_cast<Slot*>(::operator new(sizeof(Slot) * NODE_POOL_CHUNK_SIZE)));
+            usedInLastChunk = 0;
+        }
+        slot = chunks.back() + usedInLastChunk;
+        usedInLastChunk++;
+    }
+
+    Node* node = new (slot->storage) Node(std::forward<Args>(args)...);
+    count++;
+    return node;
+}
+
+/*
+    Destroys a node and puts its slot on the free list
+
+    Parameter - node: A node created by this pool (may be nullptr)
+    Return - None
+*/
+template <typename Node>
+void NodePool<Node>::destroy(Node* node) {
+    if (!node)
+        return;
+
+    node->~Node();
+    Slot* slot = reinterpret_cast<Slot*>(node);
+    slot->next = freeList;
+    freeList = slot;
+    count--;
+}
+
+/*
+    Frees every chunk of the pool
+
+    This function does not run any destructor, so the caller must have destroyed the nodes it still holds
+    (or the node type must be trivially destructible). Any pointer to a node in the pool is invalid afterwards.
+
+    Return - None
+*/
+template <typename Node>
+void NodePool<Node>::releaseAll() {
+    for (Slot* chunk : chunks) {
+        ::operator delete(chunk);
+    }
+    chunks.clear();
+    freeList = nullptr;
+    usedInLastChunk = NODE_POOL_CHUNK_SIZE;
+    count = 0;
+}
@@ -0,0 +1,321 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <utility>
+
+#include "HashTable.h"
+
+using namespace std;
+
+// Average number of keys per bucket when building the perfect hash (higher builds slower but uses less memory)
+const int PERFECT_HASH_BUCKET_SIZE = 4;
+
+// Number of displacements tried for one bucket before the build is restarted with another seed
+const uint32_t PERFECT_HASH_MAX_DISPLACEMENT = 1u << 22;
+
+// Number of seeds tried before the build gives up
+const int PERFECT_HASH_MAX_ATTEMPTS = 8;
+
+/*
+    Statistics about how the keys of a PerfectHashTable were placed
+
+    Every lookup reads one displacement and one slot whatever these numbers are. They show how hard the
+    keys were to place: many large buckets or large displacements mean the build was slow, and a build
+    that needed several seeds is close to failing.
+*/
+struct PerfectHashStats {
+    int size;                           // Number of slots (one per key)
+    int buckets;                        // Number of buckets (one displacement each)
+    int attempts;                       // Number of seeds tried before the build succeeded
+    vector<int> bucketOccupancy;        // bucketOccupancy[k] is the number of buckets holding k keys
+    vector<int> displacementCounts;     // displacementCounts[0] counts displacement 0, [i] counts 2^(i-1) to 2^i - 1
+    uint32_t maxDisplacement;           // Largest displacement of any bucket
+    double averageDisplacement;         // Average displacement over all buckets
+
+    PerfectHashStats() : size(0), buckets(0), attempts(0), maxDisplacement(0), averageDisplacement(0.0) {}
+};
+
+/*
+    PerfectHashTable class implementation (read-only table using a minimal perfect hash)
+
+    This class is built once from a fixed set of keys and then only answers lookups.
+    It uses hash-and-displace (CHD): keys are split into small buckets by their hash, and every bucket
+    is given a displacement value chosen so that the keys of all buckets land in different slots.
+    There are exactly as many slots as keys, so there are no empty slots and no probing:
+    a lookup reads the bucket's displacement, computes one slot and compares one key.
+    Values can be changed in place after the build, but keys cannot be added or removed.
+*/
+template <typename KeyType, typename MappedType, typename Hasher = DefaultHasher<KeyType>>
+class PerfectHashTable {
+public:
+    // Entries are stored in the same form as in HashTable
+    typedef typename HashTable<KeyType, MappedType, Hasher>::Entry Entry;
+    typedef typename LookupKey<KeyType>::Type KeyView;
+
+private:
+    vector<Entry> slots;                // One slot per key
+    vector<uint32_t> displacements;     // One displacement per bucket
+    unsigned long long seed;            // Seed mixed into every slot position, changed when a build attempt fails
+    int attempts;                       // Number of seeds the last successful build tried
+    Hasher hasher;
+
+    // Returns the bucket of a hash value
+    size_t bucketOf(unsigned long long hashValue) const {
+        return static_cast<size_t>(hashValue % displacements.size());
+    }
+
+    // Returns the slot of a hash value for a given displacement
+    size_t slotOf(unsigned long long hashValue, uint32_t displacement) const {
+        unsigned long long mixed = hashMultiplyFold(hashValue ^ seed, (displacement + 1ULL) * 0x9e3779b97f4a7c15ULL);
+        return static_cast<size_t>(mixed % slots.size());
+    }
+
+    // Tries to place every key with the current seed
+    bool tryBuild(const vector<unsigned long long>& hashes, vector<int>& slotOfKey);
+
+public:
+    PerfectHashTable() : seed(0), attempts(0) {}
+
+    // Builds the table from entries with distinct keys, returns false if no perfect hash could be found
+    bool build(const vector<Entry>& entries);
+
+    MappedType* find(KeyView key);
+    const MappedType* find(KeyView key) const;
+    void clear();
+
+    // Split lookup for batches: prefetch the displacement, then the slot, then find with the saved hash
+    size_t hashOf(KeyView key) const { return hasher(key); }
+    void prefetchBucket(size_t hashValue) const;
+    void prefetchSlot(size_t hashValue) const;
+    const MappedType* findWithHash(KeyView key, size_t hashValue) const;
+
+    // Returns the bucket sizes and displacements chosen by the last build
+    PerfectHashStats getStats() const;
+
+    int size() const { return static_cast<int>(slots.size()); }
+    bool isEmpty() const { return slots.empty(); }
+
+    // Returns the entry in a slot (0 to size() - 1), used to walk every entry
+    const Entry& entryAt(int slot) const { return slots[slot]; }
+};
+
+
+/*
+    Places every key in its own slot using the current seed
+
+    This function sorts the buckets from largest to smallest (counting sort by size) and, for each bucket,
+    tries displacements 0, 1, 2, ... until every key of the bucket maps to a free slot that no other key
+    of the same bucket uses. Large buckets go first while most slots are still free.
+
+    Parameter - hashes: The hash value of every key
+    Parameter - slotOfKey: Receives the slot chosen for every key
+    Return - True if every key was placed, false if some bucket ran out of displacements
+*/
+template <typename KeyType, typename MappedType, typename Hasher>
+bool PerfectHashTable<KeyType, MappedType, Hasher>::tryBuild(const vector<unsigned long long>& hashes, vector<int>& slotOfKey) {
+    size_t keyCount = hashes.size();
+    size_t bucketCount = displacements.size();
+
+    // Group the keys by bucket
+    vector<int> bucketStart(bucketCount + 1, 0);
+    for (size_t i = 0; i < keyCount; i++) {
+        bucketStart[bucketOf(hashes[i]) + 1]++;
+    }
+    int largestBucket = 0;
+    for (size_t b = 0; b < bucketCount; b++) {
+        largestBucket = max(largestBucket, bucketStart[b + 1]);
+        bucketStart[b + 1] += bucketStart[b];
+    }
+    vector<int> keysByBucket(keyCount);
+    vector<int> fill(bucketStart.begin(), bucketStart.end() - 1);
+    for (size_t i = 0; i < keyCount; i++) {
+        keysByBucket[fill[bucketOf(hashes[i])]++] = static_cast<int>(i);
+    }
+
+    // Order the buckets from largest to smallest
+    vector<vector<int>> bucketsBySize(largestBucket + 1);
+    for (size_t b = 0; b < bucketCount; b++) {
+        bucketsBySize[bucketStart[b + 1] - bucketStart[b]].push_back(static_cast<int>(b));
+    }
+
+    vector<char> taken(keyCount, 0);
+    vector<size_t> positions;
+    for (int bucketSize = largestBucket; bucketSize > 0; bucketSize--) {
+        for (int b : bucketsBySize[bucketSize]) {
+            const int* keys = &keysByBucket[bucketStart[b]];
+            uint32_t displacement = 0;
+            for (; displacement < PERFECT_HASH_MAX_DISPLACEMENT; displacement++) {
+                positions.clear();
+                bool fits = true;
+                for (int k = 0; k < bucketSize && fits; k++) {
+                    size_t position = slotOf(hashes[keys[k]], displacement);
+                    if (taken[position]) {
+                        fits = false;
+                        break;
+                    }
+                    for (size_t other : positions) {
+                        if (other == position) {
+                            fits = false;
+                            break;
+                        }
+                    }
+                    positions.push_back(position);
+                }
+                if (fits)
+                    break;
+            }
+            if (displacement == PERFECT_HASH_MAX_DISPLACEMENT)
+                return false;
+
+            displacements[b] = displacement;
+            for (int k = 0; k < bucketSize; k++) {
+                taken[positions[k]] = 1;
+                slotOfKey[keys[k]] = static_cast<int>(positions[k]);
+            }
+        }
+    }
+    return true;
+}
+
+/*
+    Builds the table from a set of entries
+
+    This function replaces the current contents. The keys of the entries must all be different.
+    If a build attempt fails the seed is changed and the build is tried again a few times.
+
+    Parameter - entries: The entries to store
+    Return - True if the table was built, false if no perfect hash was found (the table is left empty)
+*/
+template <typename KeyType, typename MappedType, typename Hasher>
+bool PerfectHashTable<KeyType, MappedType, Hasher>::build(const vector<Entry>& entries) {
+    clear();
+    if (entries.empty())
+        return true;
+
+    vector<unsigned long long> hashes(entries.size());
+    for (size_t i = 0; i < entries.size(); i++) {
+        hashes[i] = hasher(entries[i].key);
+    }
+
+    slots.resize(entries.size());
+    displacements.assign((entries.size() + PERFECT_HASH_BUCKET_SIZE - 1) / PERFECT_HASH_BUCKET_SIZE, 0);
+    vector<int> slotOfKey(entries.size());
+    for (int attempt = 0; attempt < PERFECT_HASH_MAX_ATTEMPTS; attempt++) {
+        seed = hashKey(static_cast<unsigned long long>(attempt));
+        if (tryBuild(hashes, slotOfKey)) {
+            for (size_t i = 0; i < entries.size(); i++) {
+                slots[slotOfKey[i]] = entries[i];
+            }
+            attempts = attempt + 1;
+            return true;
+        }
+    }
+
+    clear();
+    return false;
+}
+
+/*
+    Retrieves the value associated with a given key
+
+    Parameter - key: The key whose value is to be retrieved
+    Return - A pointer to the stored value if found, otherwise nullptr
+*/
+template <typename KeyType, typename MappedType, typename Hasher>
+MappedType* PerfectHashTable<KeyType, MappedType, Hasher>::find(KeyView key) {
+    const PerfectHashTable& self = *this;
+    return const_cast<MappedType*>(self.find(key));
+}
+
+template <typename KeyType, typename MappedType, typename Hasher>
+const MappedType* PerfectHashTable<KeyType, MappedType, Hasher>::find(KeyView key) const {
+    return findWithHash(key, hasher(key));
+}
+
+/*
+    Retrieves the value associated with a key whose hash is already known
+
+    Parameter - key: The key whose value is to be retrieved
+    Parameter - hashValue: The hash of the key (from hashOf)
+    Return - A pointer to the stored value if found, otherwise nullptr
+*/
+template <typename KeyType, typename MappedType, typename Hasher>
+const MappedType* PerfectHashTable<KeyType, MappedType, Hasher>::findWithHash(KeyView key, size_t hashValue) const {
+    if (slots.empty())
+        return nullptr;
+
+    const Entry& entry = slots[slotOf(hashValue, displacements[bucketOf(hashValue)])];
+    return entry.key == key ? &entry.value : nullptr;
+}
+
+/*
+    Starts loading the displacement a lookup of the hash reads first
+
+    Parameter - hashValue: The hash of the key that will be looked up
+*/
+template <typename KeyType, typename MappedType, typename Hasher>
+void PerfectHashTable<KeyType, MappedType, Hasher>::prefetchBucket(size_t hashValue) const {
+    if (!slots.empty())
+        prefetchRead(&displacements[bucketOf(hashValue)]);
+}
+
+/*
+    Starts loading the slot a lookup of the hash reads
+
+    This reads the bucket's displacement, so it should be called some time after prefetchBucket.
+
+    Parameter - hashValue: The hash of the key that will be looked up
+*/
+template <typename KeyType, typename MappedType, typename Hasher>
+void PerfectHashTable<KeyType, MappedType, Hasher>::prefetchSlot(size_t hashValue) const {
+    if (!slots.empty())
+        prefetchRead(&slots[slotOf(hashValue, displacements[bucketOf(hashValue)])]);
+}
+
+/*
+    Retrieves statistics about the buckets and displacements of the table
+
+    The bucket sizes are not stored, so this function hashes every key again (O(n)).
+
+    Return - The statistics of the last build (all zero if the table is empty)
+*/
+template <typename KeyType, typename MappedType, typename Hasher>
+PerfectHashStats PerfectHashTable<KeyType, MappedType, Hasher>::getStats() const {
+    PerfectHashStats stats;
+    stats.size = size();
+    stats.buckets = static_cast<int>(displacements.size());
+    stats.attempts = slots.empty() ? 0 : attempts;
+
+    vector<int> keysInBucket(displacements.size(), 0);
+    for (const Entry& entry : slots) {
+        keysInBucket[bucketOf(hasher(entry.key))]++;
+    }
+    for (int keys : keysInBucket) {
+        if (keys >= static_cast<int>(stats.bucketOccupancy.size()))
+            stats.bucketOccupancy.resize(keys + 1, 0);
+        stats.bucketOccupancy[keys]++;
+    }
+
+    unsigned long long total = 0;
+    for (uint32_t displacement : displacements) {
+        size_t bin = 0;
+        while (bin < 32 && (displacement >> bin) != 0) {
+            bin++;
+        }
+        if (bin >= stats.displacementCounts.size())
+            stats.displacementCounts.resize(bin + 1, 0);
+        stats.displacementCounts[bin]++;
+        stats.maxDisplacement = max(stats.maxDisplacement, displacement);
+        total += displacement;
+    }
+    stats.averageDisplacement = displacements.empty() ? 0.0 : static_cast<double>(total) / displacements.size();
+    return stats;
+}
+
+// Removes every entry
+template <typename KeyType, typename MappedType, typename Hasher>
+void PerfectHashTable<KeyType, MappedType, Hasher>::clear() {
+    vector<Entry>().swap(slots);
+    vector<uint32_t>().swap(displacements);
+}
@@ -0,0 +1,439 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <utility>
+
+#include "AVLTree.h"
+
+using namespace std;
+
+/*
+    Node of a PersistentAVLTree
+
+    A node is never changed once it is built, so it can be shared by every version of the tree that
+    contains it. Its children are reference counted, and a node is freed when no version uses it any more.
+*/
+template <typename T>
+struct PersistentAVLNode {
+    typedef shared_ptr<const PersistentAVLNode> Pointer;
+
+    T data;
+    Pointer left;
+    Pointer right;
+    int height;
+    int size;   // Number of nodes in the subtree rooted here
+
+    PersistentAVLNode(T&& value, Pointer leftChild, Pointer rightChild)
+        : data(std::move(value)), left(std::move(leftChild)), right(std::move(rightChild)),
+          height(1 + max(left ? left->height : 0, right ? right->height : 0)),
+          size(1 + (left ? left->size : 0) + (right ? right->size : 0)) {}
+};
+
+/*
+    PersistentAVLTree class implementation (AVL Tree with immutable versions for snapshot reads)
+
+    insert and remove never change an existing node. They copy the O(log n) nodes on the path from the
+    root to the change (and the few touched by rotations), share every other subtree with the previous
+    version, and then publish the new root with atomic_store. Writers are serialized by a mutex.
+
+    A reader pins the current version with snapshot(), which copies the root pointer with atomic_load.
+    It never takes the writers' mutex, so a reader does not wait for a writer to finish copying its path.
+    It is not lock-free either: atomic_load and atomic_store on a shared_ptr are not lock-free in the
+    standard libraries this project builds with (libstdc++ and MSVC guard them with a small internal lock
+    chosen by the pointer's address), so a reader briefly takes the same lock a writer takes to publish
+    a new root. That lock is held only to copy one pointer and bump its reference count; once the snapshot
+    is taken, every read through it is lock-free.
+
+    The snapshot keeps seeing exactly the elements that were in the tree at that moment, however long it is
+    held and whatever is inserted or removed meanwhile, so a long scan (e.g. a top-10 listing or a report)
+    sees a consistent view. The nodes are reference counted, so a version's nodes that no newer version
+    shares are freed when its last snapshot is released.
+
+    Elements are copied when their node is path-copied, so T should be cheap to copy (e.g. a key and a pointer
+    to a record). Lookups only use operator<, and accept any key type that can be compared with T in both
+    directions.
+
+    The root is read and published with the free functions atomic_load and atomic_store on shared_ptr, which
+    is what C++17 offers. They are deprecated in C++20; if the project's LanguageStandard moves past stdcpp17,
+    root should become an atomic<shared_ptr<const Node>> and these calls its load and store.
+*/
+template <typename T>
+class PersistentAVLTree {
+private:
+    typedef PersistentAVLNode<T> Node;
+    typedef typename Node::Pointer Pointer;
+
+    Pointer root;       // Current version, only accessed through atomic_load and atomic_store
+    mutex writeLock;    // Serializes insert, remove and clear
+
+    static int getHeight(const Pointer& node) { return node ? node->height : 0; }
+
+    // Builds a node from an element and two subtrees whose heights differ by at most 2, rotating if needed
+    static Pointer balance(T&& data, const Pointer& left, const Pointer& right);
+
+    // Returns a copy of the subtree with value added, or node itself if an equal element exists
+    static Pointer insertInto(const Pointer& node, T&& value, bool& inserted);
+
+    // Returns a copy of the subtree without the element equal to key, or node itself if there is none
+    template <typename Key>
+    static Pointer removeFrom(const Pointer& node, const Key& key, bool& removed);
+
+    // Returns a copy of the subtree without its smallest element
+    static Pointer removeMin(const Pointer& node);
+
+    // Adds a moved-in element, returns false if an equal element exists
+    bool insertValue(T&& value);
+
+public:
+    /*
+        A pinned version of the tree
+
+        A snapshot can be read from any thread without locking (only taking it locks), and keeps its version
+        alive until it is destroyed. Copying a snapshot pins the same version.
+    */
+    class Snapshot {
+    private:
+        Pointer root;
+
+        friend class PersistentAVLTree;
+        explicit Snapshot(Pointer root) : root(std::move(root)) {}
+
+    public:
+        // Returns the element equal to key, or nullptr (valid while the snapshot is held)
+        template <typename Key>
+        const T* find(const Key& key) const;
+
+        // Returns the number of elements in this version
+        int size() const { return root ? root->size : 0; }
+        bool empty() const { return !root; }
+
+        // Calls visit(element) in ascending order starting at the first element not less than low,
+        // until visit returns false or the elements run out
+        template <typename Key, typename Visitor>
+        void visitFrom(const Key& low, Visitor visit) const;
+
+        // Calls visit(element) in descending order from the largest element, until visit returns false
+        template <typename Visitor>
+        void visitDescending(Visitor visit) const;
+
+        // Get all elements of this version in sorted order
+        vector<T> getAllItems() const;
+    };
+
+    PersistentAVLTree() {}
+
+    // The tree owns its lock, so it cannot be copied (take a snapshot instead)
+    PersistentAVLTree(const PersistentAVLTree&) = delete;
+    PersistentAVLTree& operator=(const PersistentAVLTree&) = delete;
+
+    // Insert an element, returns false if an equal element is already in the tree
+    bool insert(const T& data);
+    bool insert(T&& data);
+
+    // Constructs an element from args and inserts it, returns false if it is a duplicate
+    template <typename... Args>
+    bool emplace(Args&&... args);
+
+    // Removes the element equal to key, returns false if there is none
+    template <typename Key>
+    bool remove(const Key& key);
+
+    // Publishes an empty version (existing snapshots keep their elements)
+    void clear();
+
+    // Pins the current version for reading (briefly takes the internal lock of atomic_load, see the class comment)
+    Snapshot snapshot() const { return Snapshot(atomic_load(&root)); }
+
+    // Returns the number of elements in the current version
+    int size() const { return snapshot().size(); }
+};
+
+
+/*
+    Builds a balanced node from an element and two subtrees
+
+    The subtrees come from a single insertion or removal below this node, so their heights differ by at
+    most 2. If they differ by 2, a single or double rotation is done by building new nodes for the rotated
+    positions; the subtrees below them are shared as they are.
+
+    Parameter - data: The element of the new node (moved in)
+    Parameter - left: The left subtree
+    Parameter - right: The right subtree
+    Return - The root of the balanced subtree
+*/
+template <typename T>
+typename PersistentAVLTree<T>::Pointer PersistentAVLTree<T>::balance(T&& data, const Pointer& left, const Pointer& right) {
+    int leftHeight = getHeight(left);
+    int rightHeight = getHeight(right);
+
+    if (leftHeight > rightHeight + 1) {
+        if (getHeight(left->left) >= getHeight(left->right)) {
+            // Left Left Case
+            return make_shared<const Node>(T(left->data), left->left,
+                make_shared<const Node>(std::move(data), left->right, right));
+        }
+        // Left Right Case
+        const Pointer& middle = left->right;
+        return make_shared<const Node>(T(middle->data),
+            make_shared<const Node>(T(left->data), left->left, middle->left),
+            make_shared<const Node>(std::move(data), middle->right, right));
+    }
+
+    if (rightHeight > leftHeight + 1) {
+        if (getHeight(right->right) >= getHeight(right->left)) {
+            // Right Right Case
+            return make_shared<const Node>(T(right->data),
+                make_shared<const Node>(std::move(data), left, right->left), right->right);
+        }
+        // Right Left Case
+        const Pointer& middle = right->left;
+        return make_shared<const Node>(T(middle->data),
+            make_shared<const Node>(std::move(data), left, middle->left),
+            make_shared<const Node>(T(right->data), middle->right, right->right));
+    }
+
+    return make_shared<const Node>(std::move(data), left, right);
+}
+
+/*
+    Path-copies a subtree with a new element added
+
+    Parameter - node: The root of the subtree (may be nullptr)
+    Parameter - value: The element to add (moved from only if it is added)
+    Parameter - inserted: Set to false if an equal element is already in the subtree
+    Return - The root of the new subtree
+*/
+template <typename T>
+typename PersistentAVLTree<T>::Pointer PersistentAVLTree<T>::insertInto(const Pointer& node, T&& value, bool& inserted) {
+    if (!node)
+        return make_shared<const Node>(std::move(value), nullptr, nullptr);
+
+    if (value < node->data) {
+        Pointer left = insertInto(node->left, std::move(value), inserted);
+        return inserted ? balance(T(node->data), left, node->right) : node;
+    }
+    if (node->data < value) {
+        Pointer right = insertInto(node->right, std::move(value), inserted);
+        return inserted ? balance(T(node->data), node->left, right) : node;
+    }
+
+    inserted = false; // Duplicate keys are not allowed
+    return node;
+}
+
+/*
+    Path-copies a subtree without its smallest element
+
+    Parameter - node: The root of a non-empty subtree
+    Return - The root of the new subtree
+*/
+template <typename T>
+typename PersistentAVLTree<T>::Pointer PersistentAVLTree<T>::removeMin(const Pointer& node) {
+    if (!node->left)
+        return node->right;
+    return balance(T(node->data), removeMin(node->left), node->right);
+}
+
+/*
+    Path-copies a subtree without the element equal to a key
+
+    A node with two children is replaced by a copy of its in-order successor.
+
+    Parameter - node: The root of the subtree (may be nullptr)
+    Parameter - key: The data (or a key comparable with it) of the element to be removed
+    Parameter - removed: Set to true if an element was removed
+    Return - The root of the new subtree
+*/
+template <typename T>
+template <typename Key>
+typename PersistentAVLTree<T>::Pointer PersistentAVLTree<T>::removeFrom(const Pointer& node, const Key& key, bool& removed) {
+    if (!node)
+        return node;
+
+    if (key < node->data) {
+        Pointer left = removeFrom(node->left, key, removed);
+        return removed ? balance(T(node->data), left, node->right) : node;
+    }
+    if (node->data < key) {
+        Pointer right = removeFrom(node->right, key, removed);
+        return removed ? balance(T(node->data), node->left, right) : node;
+    }
+
+    removed = true;
+    if (!node->left)
+        return node->right;
+    if (!node->right)
+        return node->left;
+
+    const Node* successor = node->right.get();
+    while (successor->left)
+        successor = successor->left.get();
+    return balance(T(successor->data), node->left, removeMin(node->right));
+}
+
+/*
+    Inserts an element and publishes the new version
+
+    Parameter - value: The element to insert (moved into the tree)
+    Return - True if the element was inserted, false if an equal element is already in the tree
+*/
+template <typename T>
+bool PersistentAVLTree<T>::insertValue(T&& value) {
+    lock_guard<mutex> guard(writeLock);
+    bool inserted = true;
+    Pointer newRoot = insertInto(atomic_load(&root), std::move(value), inserted);
+    if (inserted)
+        atomic_store(&root, std::move(newRoot));
+    return inserted;
+}
+
+template <typename T>
+bool PersistentAVLTree<T>::insert(const T& data) {
+    return insertValue(T(data));
+}
+
+template <typename T>
+bool PersistentAVLTree<T>::insert(T&& data) {
+    return insertValue(std::move(data));
+}
+
+template <typename T>
+template <typename... Args>
+bool PersistentAVLTree<T>::emplace(Args&&... args) {
+    return insertValue(T(std::forward<Args>(args)...));
+}
+
+/*
+    Removes the element equal to a key and publishes the new version
+
+    Snapshots taken before the removal still contain the element.
+
+    Parameter - key: The data (or a key comparable with it) of the element to be removed
+    Return - True if an element was removed, false if no element is equal to key
+*/
+template <typename T>
+template <typename Key>
+bool PersistentAVLTree<T>::remove(const Key& key) {
+    lock_guard<mutex> guard(writeLock);
+    bool removed = false;
+    Pointer newRoot = removeFrom(atomic_load(&root), key, removed);
+    if (removed)
+        atomic_store(&root, std::move(newRoot));
+    return removed;
+}
+
+template <typename T>
+void PersistentAVLTree<T>::clear() {
+    lock_guard<mutex> guard(writeLock);
+    atomic_store(&root, Pointer());
+}
+
+/*
+    Finds the element equal to a key in the snapshot's version
+
+    Parameter - key: The data (or a key comparable with it) to search for
+    Return - A pointer to the data if found, otherwise nullptr
+*/
+template <typename T>
+template <typename Key>
+const T* PersistentAVLTree<T>::Snapshot::find(const Key& key) const {
+    const Node* node = root.get();
+    while (node) {
+        if (key < node->data)
+            node = node->left.get();
+        else if (node->data < key)
+            node = node->right.get();
+        else
+            return &node->data;
+    }
+    return nullptr;
+}
+
+/*
+    Visits the snapshot's elements in ascending order from a starting value
+
+    This function walks the tree with an explicit stack, starting with the path to the first
+    element not less than low.
+
+    Parameter - low: The smallest value (or key) to visit
+    Parameter - visit: A callable taking a const T& and returning true to continue or false to stop
+*/
+template <typename T>
+template <typename Key, typename Visitor>
+void PersistentAVLTree<T>::Snapshot::visitFrom(const Key& low, Visitor visit) const {
+    const Node* stack[AVL_TREE_MAX_HEIGHT];
+    int depth = 0;
+
+    // Keep the nodes not less than low on the path down, they are visited in reverse order
+    const Node* node = root.get();
+    while (node) {
+        if (node->data < low) {
+            node = node->right.get();
+        }
+        else {
+            stack[depth++] = node;
+            node = node->left.get();
+        }
+    }
+
+    while (depth > 0) {
+        node = stack[--depth];
+        if (!visit(node->data))
+            return;
+        for (node = node->right.get(); node; node = node->left.get()) {
+            stack[depth++] = node;
+        }
+    }
+}
+
+/*
+    Visits the snapshot's elements in descending order
+
+    Parameter - visit: A callable taking a const T& and returning true to continue or false to stop
+*/
+template <typename T>
+template <typename Visitor>
+void PersistentAVLTree<T>::Snapshot::visitDescending(Visitor visit) const {
+    const Node* stack[AVL_TREE_MAX_HEIGHT];
+    int depth = 0;
+
+    for (const Node* node = root.get(); node; node = node->right.get()) {
+        stack[depth++] = node;
+    }
+    while (depth > 0) {
+        const Node* node = stack[--depth];
+        if (!visit(node->data))
+            return;
+        for (node = node->left.get(); node; node = node->right.get()) {
+            stack[depth++] = node;
+        }
+    }
+}
+
+/*
+    Returns all elements of the snapshot's version in sorted order.
+
+    Return - A vector containing the elements in sorted order
+*/
+template <typename T>
+vector<T> PersistentAVLTree<T>::Snapshot::getAllItems() const {
+    vector<T> items;
+    items.reserve(size());
+    const Node* stack[AVL_TREE_MAX_HEIGHT];
+    int depth = 0;
+
+    for (const Node* node = root.get(); node; node = node->left.get()) {
+        stack[depth++] = node;
+    }
+    while (depth > 0) {
+        const Node* node = stack[--depth];
+        items.push_back(node->data);
+        for (node = node->right.get(); node; node = node->left.get()) {
+            stack[depth++] = node;
+        }
+    }
+    return items;
+}
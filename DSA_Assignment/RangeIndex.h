@@ -0,0 +1,246 @@
+#pragma once
+
+#include "AVLTree.h"
+#include "RecordId.h"
+
+using namespace std;
+
+/*
+    Entry of a RangeIndex: a record filed under a key
+
+    Entries are ordered by key and then by record ID, so records sharing a key (e.g. movies from the
+    same year) are all kept and come out in a fixed order. An entry can also be compared with a bare key,
+    which is how the index searches for the first and last entries of a key range.
+*/
+template <typename ValueType, typename KeyType>
+struct RangeIndexEntry {
+    KeyType key;
+    RecordId id;
+    ValueType* value;
+
+    RangeIndexEntry(const KeyType& key, ValueType* value) : key(key), id(value->id), value(value) {}
+
+    bool operator<(const RangeIndexEntry& other) const {
+        return key < other.key || (key == other.key && id < other.id);
+    }
+
+    friend bool operator<(const RangeIndexEntry& entry, const KeyType& key) {
+        return entry.key < key;
+    }
+
+    friend bool operator<(const KeyType& key, const RangeIndexEntry& entry) {
+        return key < entry.key;
+    }
+};
+
+/*
+    Aggregate summarizing the ratings of the records in a RangeIndex subtree
+
+    Only records that have been rated at least once are counted. The best record is the one with the
+    highest average rating (the lower ID wins a tie, so the result does not depend on the tree's shape).
+*/
+template <typename ValueType>
+struct RatingAggregate {
+    ValueType* best;        // Highest-rated record, nullptr if no record has been rated
+    double ratingSum;       // Sum of the average ratings of the rated records
+    int ratedCount;         // Number of rated records
+
+    RatingAggregate() : best(nullptr), ratingSum(0.0), ratedCount(0) {}
+
+    // Summarizes one index entry
+    template <typename Entry>
+    void reset(const Entry& entry) {
+        ValueType* value = entry.value;
+        bool rated = value->noOfTimesRated > 0;
+        best = rated ? value : nullptr;
+        ratingSum = rated ? value->rating : 0.0;
+        ratedCount = rated ? 1 : 0;
+    }
+
+    // Adds the records of another summary
+    void merge(const RatingAggregate& other) {
+        if (other.best && (!best || other.best->rating > best->rating ||
+            (other.best->rating == best->rating && other.best->id < best->id)))
+            best = other.best;
+        ratingSum += other.ratingSum;
+        ratedCount += other.ratedCount;
+    }
+
+    // Returns the mean of the records' average ratings, or 0 if no record has been rated
+    double averageRating() const {
+        return ratedCount > 0 ? ratingSum / ratedCount : 0.0;
+    }
+};
+
+/*
+    RangeIndex class implementation (secondary index from a field to records, ordered by the field)
+
+    This class keeps records sorted by a field (e.g. a movie's year, an actor's birth year or a rating)
+    in an AVL Tree, so the records whose field falls between two values can be listed in O(log n + k)
+    by walking the tree in place, instead of scanning the whole Dictionary and sorting the matches.
+    The tree counts the entries below every node, so the records with the largest keys and the rank
+    of a record are also found in O(log n + k) and O(log n).
+    An Aggregate (e.g. RatingAggregate) can also be kept for every subtree, so a summary of all records in a
+    key range, such as the best-rated movie released between two years, is found in O(log n).
+    The index does not own the records; the caller must keep it in sync when the field changes, and must
+    call refresh when a field the Aggregate reads changes.
+    ValueType must have a RecordId member named id.
+*/
+template <typename ValueType, typename KeyType = int, typename Aggregate = NoAggregate>
+class RangeIndex {
+private:
+    typedef RangeIndexEntry<ValueType, KeyType> Entry;
+    typedef AVLTree<Entry, Aggregate> Tree;
+
+    Tree tree;
+
+public:
+    // Adds a record under the given key
+    void add(const KeyType& key, ValueType* value);
+
+    // Removes a record from under the given key
+    bool remove(const KeyType& key, ValueType* value);
+
+    // Moves a record from its old key to its new key
+    void rekey(const KeyType& oldKey, const KeyType& newKey, ValueType* value);
+
+    // Calls visit(value) for every record with low <= key <= high, in ascending key order
+    template <typename Visitor>
+    void forEachInRange(const KeyType& low, const KeyType& high, Visitor visit) const;
+
+    // Calls visit(value) for every record with low <= key <= high, in descending key order
+    template <typename Visitor>
+    void forEachInRangeDescending(const KeyType& low, const KeyType& high, Visitor visit) const;
+
+    // Calls visit(value) for the count records with the largest keys, largest first
+    template <typename Visitor>
+    void forEachTop(int count, Visitor visit) const;
+
+    // Returns the position of a record in the order forEachTop visits them (0 for the top record)
+    int countAbove(const KeyType& key, ValueType* value) const;
+
+    // Returns the summary of every record with low <= key <= high
+    Aggregate aggregateInRange(const KeyType& low, const KeyType& high) const { return tree.aggregate(low, high); }
+
+    // Updates the summaries that include a record after a field the Aggregate reads has changed
+    void refresh(const KeyType& key, ValueType* value) { tree.refresh(Entry(key, value)); }
+
+    // Returns the number of records in the index
+    int size() const { return tree.size(); }
+};
+
+
+/*
+    Adds a record to the index
+
+    Parameter - key: The value the record is filed under
+    Parameter - value: The record
+    Return - None
+*/
+template <typename ValueType, typename KeyType, typename Aggregate>
+void RangeIndex<ValueType, KeyType, Aggregate>::add(const KeyType& key, ValueType* value) {
+    tree.emplace(key, value);
+}
+
+/*
+    Removes a record from the index
+
+    Parameter - key: The value the record was filed under
+    Parameter - value: The record
+    Return - True if the record was found and removed, false otherwise
+*/
+template <typename ValueType, typename KeyType, typename Aggregate>
+bool RangeIndex<ValueType, KeyType, Aggregate>::remove(const KeyType& key, ValueType* value) {
+    return tree.remove(Entry(key, value));
+}
+
+/*
+    Moves a record to a new key
+
+    This function is called when the indexed field of a record changes (e.g. a movie's year is updated).
+
+    Parameter - oldKey: The value the record was filed under
+    Parameter - newKey: The value the record should now be filed under
+    Parameter - value: The record
+    Return - None
+*/
+template <typename ValueType, typename KeyType, typename Aggregate>
+void RangeIndex<ValueType, KeyType, Aggregate>::rekey(const KeyType& oldKey, const KeyType& newKey, ValueType* value) {
+    if (oldKey == newKey)
+        return;
+    remove(oldKey, value);
+    add(newKey, value);
+}
+
+/*
+    Visits the records whose key lies in a range, smallest key first
+
+    Parameter - low: The smallest key to visit
+    Parameter - high: The largest key to visit
+    Parameter - visit: A callable taking a ValueType*
+    Return - None
+*/
+template <typename ValueType, typename KeyType, typename Aggregate>
+template <typename Visitor>
+void RangeIndex<ValueType, KeyType, Aggregate>::forEachInRange(const KeyType& low, const KeyType& high, Visitor visit) const {
+    for (const Entry& entry : tree.range(low, high)) {
+        visit(entry.value);
+    }
+}
+
+/*
+    Visits the records whose key lies in a range, largest key first
+
+    This function walks the range backwards from its last entry, e.g. to list actors from youngest
+    to oldest when they are indexed by birth year.
+
+    Parameter - low: The smallest key to visit
+    Parameter - high: The largest key to visit
+    Parameter - visit: A callable taking a ValueType*
+    Return - None
+*/
+template <typename ValueType, typename KeyType, typename Aggregate>
+template <typename Visitor>
+void RangeIndex<ValueType, KeyType, Aggregate>::forEachInRangeDescending(const KeyType& low, const KeyType& high, Visitor visit) const {
+    typename Tree::Range entries = tree.range(low, high);
+    typename Tree::const_iterator it = entries.end();
+    while (it != entries.begin()) {
+        --it;
+        visit(it->value);
+    }
+}
+
+/*
+    Visits the records with the largest keys, largest first
+
+    This function walks backwards from the last entry, so only the visited entries are touched.
+    Records with equal keys are visited in descending order of ID.
+
+    Parameter - count: The number of records to visit (fewer if the index is smaller)
+    Parameter - visit: A callable taking a ValueType*
+    Return - None
+*/
+template <typename ValueType, typename KeyType, typename Aggregate>
+template <typename Visitor>
+void RangeIndex<ValueType, KeyType, Aggregate>::forEachTop(int count, Visitor visit) const {
+    typename Tree::const_iterator it = tree.end();
+    for (int i = 0; i < count && it != tree.begin(); i++) {
+        --it;
+        visit(it->value);
+    }
+}
+
+/*
+    Counts the records ranked above a record
+
+    Records with equal keys are ranked by descending ID, the same order forEachTop uses,
+    so the result is the record's position (starting at 0) in that order.
+
+    Parameter - key: The key the record is filed under
+    Parameter - value: The record
+    Return - The number of records visited before this one by forEachTop
+*/
+template <typename ValueType, typename KeyType, typename Aggregate>
+int RangeIndex<ValueType, KeyType, Aggregate>::countAbove(const KeyType& key, ValueType* value) const {
+    return tree.size() - tree.rank(Entry(key, value)) - 1;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <vector>
+#include <new>
+#include <utility>
+
+using namespace std;
+
+#ifndef RECORD_ARENA_CHUNK_SIZE
+#define RECORD_ARENA_CHUNK_SIZE 1024   // Records per chunk
+#endif
+
+/*
+    RecordArena class implementation (chunked storage for records)
+
+    This class constructs records inside large chunks of memory instead of giving each
+    record its own heap allocation. Records that are created one after another sit next
+    to each other in memory, so scans over them touch memory roughly in order.
+    A chunk is never moved or resized once allocated, so a record keeps its address for
+    the whole life of the arena and pointers to it (e.g. from a NameIndex or a RangeIndex) stay valid.
+    Records cannot be freed one at a time; every record is destroyed together when the arena is destroyed.
+*/
+template <typename T>
+class RecordArena {
+private:
+    vector<T*> chunks;      // Raw storage, each chunk holds RECORD_ARENA_CHUNK_SIZE records
+    int usedInLastChunk;    // Number of records constructed in the last chunk
+    int count;              // Total number of records constructed
+
+public:
+    RecordArena() : usedInLastChunk(RECORD_ARENA_CHUNK_SIZE), count(0) {}
+    ~RecordArena() { clear(); }
+
+    // The arena owns its records, so it cannot be copied
+    RecordArena(const RecordArena&) = delete;
+    RecordArena& operator=(const RecordArena&) = delete;
+
+    // Constructs a new record in the arena and returns a pointer to it
+    template <typename... Args>
+    T* create(Args&&... args);
+
+    // Destroys every record and frees every chunk
+    void clear();
+
+    // Returns the number of records in the arena
+    int size() const { return count; }
+};
+
+
+/*
+    Constructs a new record in the arena
+
+    This function places the record in the next free slot of the last chunk,
+    allocating a new chunk first if the last one is full.
+
+    Parameter - args: The arguments passed to the record's constructor
+    Return - A pointer to the new record (valid until the arena is cleared or destroyed)
+*/
+template <typename T>
+template <typename... Args>
+T* RecordArena<T>::create(Args&&... args) {
+    if (usedInLastChunk == RECORD_ARENA_CHUNK_SIZE) {
+        chunks.push_back(static_cast<T*>(::operator new(sizeof(T) * RECORD_ARENA_CHUNK_SIZE)));
+        usedInLastChunk = 0;
+    }
+    T* record = new (chunks.back() + usedInLastChunk) T(std::forward<Args>(args)...);
+    usedInLastChunk++;
+    count++;
+    return record;
+}
+
+/*
+    Destroys every record in the arena
+
+    This function runs the destructor of every record in every chunk and then frees the chunks.
+    Any pointer to a record in the arena is invalid afterwards.
+
+    Return - None
+*/
+template <typename T>
+void RecordArena<T>::clear() {
+    for (size_t c = 0; c < chunks.size(); c++) {
+        int used = (c + 1 == chunks.size()) ? usedInLastChunk : RECORD_ARENA_CHUNK_SIZE;
+        for (int i = 0; i < used; i++) {
+            chunks[c][i].~T();
+        }
+        ::operator delete(chunks[c]);
+    }
+    chunks.clear();
+    usedInLastChunk = RECORD_ARENA_CHUNK_SIZE;
+    count = 0;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <charconv>
+
+using namespace std;
+
+// Type of actor and movie IDs. Every ID in the CSV files is a non-negative integer
+typedef uint32_t RecordId;
+
+/*
+    Parses an actor or movie ID
+
+    This function converts the text of an ID (e.g. a CSV field or user input) into a RecordId.
+    Surrounding spaces, tabs and carriage returns are ignored, anything else must be digits.
+    It reads straight from the given text, so no string is allocated.
+
+    Parameter - text: The text to parse
+    Parameter - id: Receives the parsed ID if parsing succeeds
+    Return - True if the text is a valid ID, false otherwise
+*/
+inline bool parseRecordId(string_view text, RecordId& id) {
+    size_t start = text.find_first_not_of(" \t\r");
+    size_t end = text.find_last_not_of(" \t\r");
+    if (start == string_view::npos)
+        return false;
+    const char* first = text.data() + start;
+    const char* last = text.data() + end + 1;
+    from_chars_result result = from_chars(first, last, id);
+    return result.ec == errc() && result.ptr == last;
+}
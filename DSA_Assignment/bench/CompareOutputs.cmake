@@ -0,0 +1,14 @@
+# Runs two programs with the same arguments and fails if their standard output differs.
+# Usage: cmake -DFIRST=<program> -DSECOND=<program> -DARGS=<arguments> -P CompareOutputs.cmake
+separate_arguments(ARGUMENT_LIST NATIVE_COMMAND "${ARGS}")
+
+execute_process(COMMAND ${FIRST} ${ARGUMENT_LIST} OUTPUT_VARIABLE FIRST_OUTPUT RESULT_VARIABLE FIRST_RESULT)
+execute_process(COMMAND ${SECOND} ${ARGUMENT_LIST} OUTPUT_VARIABLE SECOND_OUTPUT RESULT_VARIABLE SECOND_RESULT)
+
+if(NOT FIRST_RESULT EQUAL 0 OR NOT SECOND_RESULT EQUAL 0)
+    message(FATAL_ERROR "[Error] A program failed (exit codes ${FIRST_RESULT} and ${SECOND_RESULT})")
+endif()
+if(NOT FIRST_OUTPUT STREQUAL SECOND_OUTPUT)
+    message(FATAL_ERROR "[Error] Outputs differ:\n--- ${FIRST}\n${FIRST_OUTPUT}\n--- ${SECOND}\n${SECOND_OUTPUT}")
+endif()
+message(STATUS "[Success] Both programs printed:\n${FIRST_OUTPUT}")
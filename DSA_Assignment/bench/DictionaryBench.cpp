@@ -0,0 +1,518 @@
+/*
+    DictionaryBench - timings and cross-checks for the hash tables behind Dictionary
+
+    Usage: DictionaryBench [--quick] [--verify] [section...]
+
+    Sections (all of them run if none is named):
+      lookup  - Dictionary::get against the old AVL-bucket Dictionary (101 buckets, one AVL tree each)
+      scaling - ConcurrentDictionary read throughput with 1, 2, 4, ... threads on a mostly-read workload
+      cast    - Loading a synthetic cast CSV with one get per row against parsing first and calling getMany
+
+    --quick   Uses small sizes only, for a fast smoke run
+    --verify  Runs a fixed sequence of HashTable operations against std::unordered_map instead of timing
+              anything, and prints a fingerprint of the resulting tables (statistics and slot order).
+              The program is built twice, with the SSE2 control byte scans and with HASH_TABLE_NO_SIMD;
+              both builds must print the same fingerprint (see the HashTableSimdMatchesScalar test).
+*/
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <thread>
+#include <fstream>
+#include <filesystem>
+#include <string_view>
+
+#include "HashTable.h"
+#include "Dictionary.h"
+#include "ConcurrentDictionary.h"
+#include "AVLTree.h"
+#include "Actor.h"
+#include "Movie.h"
+#include "RecordId.h"
+
+using namespace std;
+
+namespace {
+
+// ==================== Helpers ====================
+
+/*
+    Times a piece of work
+
+    Parameter - work: A callable run once
+    Return - The elapsed time in milliseconds
+*/
+template <typename Work>
+double timeMilliseconds(Work work) {
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    work();
+    chrono::steady_clock::time_point end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+/*
+    Generates distinct random record IDs
+
+    The IDs are drawn below 12,000,000, the range of the IDs in actors.csv and movies.csv.
+
+    Parameter - count: The number of IDs
+    Parameter - seed: The random seed, so every run uses the same IDs
+    Parameter - exclude: IDs that must not be generated (e.g. to build a set of misses)
+    Return - The IDs in random order
+*/
+vector<RecordId> makeIds(int count, unsigned seed, const unordered_set<RecordId>& exclude = unordered_set<RecordId>()) {
+    mt19937 random(seed);
+    uniform_int_distribution<RecordId> distribution(1, 12000000);
+    unordered_set<RecordId> seen;
+    vector<RecordId> ids;
+    ids.reserve(count);
+    while (static_cast<int>(ids.size()) < count) {
+        RecordId id = distribution(random);
+        if (!exclude.count(id) && seen.insert(id).second)
+            ids.push_back(id);
+    }
+    return ids;
+}
+
+// Prints one timing line: total milliseconds and nanoseconds per operation
+void printTiming(const string& label, double milliseconds, long long operations) {
+    cout << "  " << left << setw(44) << label << right << fixed << setprecision(1)
+         << setw(10) << milliseconds << " ms" << setw(10) << milliseconds * 1e6 / operations << " ns/op\n";
+}
+
+// ==================== Old AVL-bucket Dictionary ====================
+
+// Number of buckets of the old Dictionary (a prime near 100)
+const int LEGACY_BUCKETS = 101;
+
+/*
+    LegacyDictionary - the Dictionary this project started with, kept here as the baseline
+
+    Keys are ID strings hashed with hash * 31 + c modulo 101, and each bucket is an AVL tree of key-value pairs.
+    It uses today's (iterative, pooled) AVLTree, so the old layout is measured at its best.
+*/
+class LegacyDictionary {
+private:
+    AVLTree<KeyValuePair<string, Actor>> table[LEGACY_BUCKETS];
+
+    static unsigned long hash(const string& key) {
+        unsigned long hashValue = 0;
+        for (char c : key) {
+            hashValue = (hashValue * 31 + c) % LEGACY_BUCKETS;
+        }
+        return hashValue;
+    }
+
+public:
+    bool add(const string& key, Actor* value) {
+        return table[hash(key)].emplace(key, value);
+    }
+
+    Actor* get(const string& key) const {
+        KeyValuePair<string, Actor>* found = table[hash(key)].find(key);
+        return found ? found->value : nullptr;
+    }
+};
+
+// ==================== Sections ====================
+
+/*
+    Times lookups in the old AVL-bucket Dictionary, a HashTable with the same string keys, and today's Dictionary
+
+    Every structure is looked up with the same shuffled hits and the same misses.
+
+    Parameter - sizes: The numbers of entries to test with
+*/
+void benchmarkLookup(const vector<int>& sizes) {
+    cout << "\n[lookup] Dictionary::get against the old AVL-bucket Dictionary ("
+#ifdef HASH_TABLE_USE_SSE2
+         << "SSE2"
+#else
+         << "scalar"
+#endif
+         << " control byte scans)\n";
+
+    for (int size : sizes) {
+        vector<RecordId> ids = makeIds(size, 1);
+        unordered_set<RecordId> present(ids.begin(), ids.end());
+        vector<RecordId> misses = makeIds(size, 2, present);
+
+        vector<Actor> actors;
+        actors.reserve(size);
+        for (RecordId id : ids) {
+            actors.emplace_back(id, "Actor " + to_string(id), 1970);
+        }
+
+        vector<string> idStrings, missStrings;
+        for (RecordId id : ids) idStrings.push_back(to_string(id));
+        for (RecordId id : misses) missStrings.push_back(to_string(id));
+
+        LegacyDictionary legacy;
+        HashTable<string, Actor*> stringTable;
+        Dictionary<RecordId, Actor> dictionary;
+        for (int i = 0; i < size; i++) {
+            legacy.add(idStrings[i], &actors[i]);
+            stringTable.insert(idStrings[i], &actors[i]);
+            dictionary.add(ids[i], &actors[i]);
+        }
+
+        // Look the keys up in a different order from the one they were added in
+        vector<int> order(size);
+        for (int i = 0; i < size; i++) order[i] = i;
+        shuffle(order.begin(), order.end(), mt19937(3));
+
+        long long found = 0;
+        cout << "\n n = " << size << "\n";
+        printTiming("AVL buckets, string keys, hits", timeMilliseconds([&]() {
+            for (int i : order) found += legacy.get(idStrings[i]) != nullptr;
+        }), size);
+        printTiming("AVL buckets, string keys, misses", timeMilliseconds([&]() {
+            for (int i : order) found += legacy.get(missStrings[i]) != nullptr;
+        }), size);
+        printTiming("HashTable, string keys, hits", timeMilliseconds([&]() {
+            for (int i : order) found += stringTable.find(idStrings[i]) != nullptr;
+        }), size);
+        printTiming("HashTable, string keys, misses", timeMilliseconds([&]() {
+            for (int i : order) found += stringTable.find(missStrings[i]) != nullptr;
+        }), size);
+        printTiming("Dictionary<RecordId>, hits", timeMilliseconds([&]() {
+            for (int i : order) found += dictionary.get(ids[i]) != nullptr;
+        }), size);
+        printTiming("Dictionary<RecordId>, misses", timeMilliseconds([&]() {
+            for (int i : order) found += dictionary.get(misses[i]) != nullptr;
+        }), size);
+
+        if (found != 3LL * size) {
+            cout << "[Error] Expected " << 3LL * size << " hits, found " << found << "\n";
+        }
+    }
+}
+
+/*
+    Measures how ConcurrentDictionary throughput grows with the number of threads
+
+    Every thread does the same number of operations on a shared, pre-filled dictionary: 95% get on random
+    keys and 5% update (adding a rating under the stripe's write lock). With perfect scaling the elapsed time
+    stays flat as threads are added, so the throughput grows linearly. A single-threaded run on a plain
+    Dictionary shows the cost of the locking itself.
+
+    Parameter - size: The number of records in the dictionary
+    Parameter - operationsPerThread: The number of operations each thread does
+*/
+void benchmarkScaling(int size, int operationsPerThread) {
+    unsigned cores = thread::hardware_concurrency();
+    cout << "\n[scaling] ConcurrentDictionary, 95% get / 5% update, " << size << " records, "
+         << operationsPerThread << " operations per thread (" << cores << " hardware threads)\n";
+
+    vector<RecordId> ids = makeIds(size, 4);
+    vector<Actor> actors;
+    actors.reserve(size);
+    for (RecordId id : ids) {
+        actors.emplace_back(id, "Actor " + to_string(id), 1970);
+    }
+
+    ConcurrentDictionary<RecordId, Actor> concurrent;
+    Dictionary<RecordId, Actor> plain;
+    for (int i = 0; i < size; i++) {
+        concurrent.add(ids[i], &actors[i]);
+        plain.add(ids[i], &actors[i]);
+    }
+
+    // One thread's work; returns the number of records found so the loop is not optimized away
+    auto work = [&](unsigned seed, auto lookup, auto update) {
+        mt19937 random(seed);
+        long long found = 0;
+        for (int i = 0; i < operationsPerThread; i++) {
+            RecordId key = ids[random() % size];
+            if (random() % 20 == 0)
+                found += update(key);
+            else
+                found += lookup(key) != nullptr;
+        }
+        return found;
+    };
+
+    long long plainFound = 0;
+    double plainTime = timeMilliseconds([&]() {
+        plainFound = work(1, [&](RecordId key) { return plain.get(key); },
+            [&](RecordId key) { Actor* actor = plain.get(key); if (actor) actor->updateRating(4); return actor != nullptr; });
+    });
+    cout << "  " << left << setw(26) << "Dictionary, 1 thread" << right << fixed << setprecision(2)
+         << setw(10) << operationsPerThread / plainTime / 1000.0 << " M ops/s\n";
+
+    unsigned maxThreads = max(4u, cores);
+    double baseline = 0;
+    for (unsigned threadCount = 1; threadCount <= maxThreads; threadCount *= 2) {
+        atomic<long long> found(0);
+        double elapsed = timeMilliseconds([&]() {
+            vector<thread> threads;
+            for (unsigned t = 0; t < threadCount; t++) {
+                threads.emplace_back([&, t]() {
+                    found += work(t + 1, [&](RecordId key) { return concurrent.get(key); },
+                        [&](RecordId key) { return concurrent.update(key, [](Actor* actor) { actor->updateRating(4); }); });
+                });
+            }
+            for (thread& worker : threads) {
+                worker.join();
+            }
+        });
+        double throughput = static_cast<double>(operationsPerThread) * threadCount / elapsed / 1000.0;
+        if (threadCount == 1)
+            baseline = throughput;
+        cout << "  " << left << setw(26) << ("ConcurrentDictionary, " + to_string(threadCount) + (threadCount == 1 ? " thread" : " threads"))
+             << right << fixed << setprecision(2) << setw(10) << throughput << " M ops/s"
+             << setw(8) << throughput / baseline << "x\n";
+        if (found.load() != static_cast<long long>(operationsPerThread) * threadCount) {
+            cout << "[Error] Some lookups missed\n";
+        }
+    }
+    if (plainFound != operationsPerThread) {
+        cout << "[Error] Some lookups missed\n";
+    }
+    if (cores < 4) {
+        cout << "[Info] Only " << cores << " hardware threads; scaling beyond that is not measurable on this machine\n";
+    }
+}
+
+/*
+    Splits the two IDs out of a cast CSV line (ActorID,MovieID), the same way loadCastsFromCSV does
+
+    Parameter - line: The line to parse
+    Parameter - actorId: Receives the actor ID
+    Parameter - movieId: Receives the movie ID
+    Return - True if both IDs were parsed
+*/
+bool parseCastLine(const string& line, RecordId& actorId, RecordId& movieId) {
+    string_view fields(line);
+    size_t comma = fields.find(',');
+    if (comma == string_view::npos)
+        return false;
+    string_view movieField = fields.substr(comma + 1);
+    return parseRecordId(fields.substr(0, comma), actorId) && parseRecordId(movieField.substr(0, movieField.find(',')), movieId);
+}
+
+/*
+    Times the two ways of loading cast relationships from a CSV file
+
+    A synthetic cast file is written to the temporary directory: random pairs of loaded actor and movie IDs,
+    with 1% of the rows naming an ID that is not loaded. Both dictionaries are frozen, as they are in the
+    application when the casts are loaded. The per-row loader reads a line and calls get for its actor and
+    its movie before reading the next line, as the application did before getMany. The batched loader parses
+    every line first, then resolves all the IDs with getMany (the current loadCastsFromCSV). Only the lookups
+    differ: both count the rows whose actor and movie were both found.
+
+    Parameter - recordCount: The number of actors and of movies
+    Parameter - rowCount: The number of rows in the cast file
+*/
+void benchmarkCast(int recordCount, int rowCount) {
+    cout << "\n[cast] Cast CSV loading, " << recordCount << " actors and movies, " << rowCount << " rows\n";
+
+    vector<RecordId> actorIds = makeIds(recordCount, 5);
+    vector<RecordId> movieIds = makeIds(recordCount, 6);
+    vector<Actor> actors;
+    vector<Movie> movies;
+    actors.reserve(recordCount);
+    movies.reserve(recordCount);
+    Dictionary<RecordId, Actor> actorDictionary;
+    Dictionary<RecordId, Movie> movieDictionary;
+    for (int i = 0; i < recordCount; i++) {
+        actors.emplace_back(actorIds[i], "Actor " + to_string(actorIds[i]), 1970);
+        movies.emplace_back(movieIds[i], "Movie " + to_string(movieIds[i]), "", "2000");
+        actorDictionary.add(actorIds[i], &actors[i]);
+        movieDictionary.add(movieIds[i], &movies[i]);
+    }
+    actorDictionary.freeze();
+    movieDictionary.freeze();
+
+    filesystem::path fileName = filesystem::temp_directory_path() / "DictionaryBench_cast.csv";
+    {
+        ofstream file(fileName);
+        if (!file.is_open()) {
+            cout << "[Error] Failed to create " << fileName.string() << endl;
+            return;
+        }
+        mt19937 random(7);
+        file << "ActorID,MovieID\n";
+        for (int row = 0; row < rowCount; row++) {
+            RecordId actorId = actorIds[random() % recordCount];
+            RecordId movieId = movieIds[random() % recordCount];
+            if (random() % 100 == 0)
+                actorId = 12000000 + random() % 1000;
+            file << actorId << "," << movieId << "\n";
+        }
+    }
+
+    // Reading without lookups, to show how much of each loader is parsing
+    long long parsedRows = 0;
+    double parseTime = timeMilliseconds([&]() {
+        ifstream file(fileName);
+        string line;
+        getline(file, line);
+        RecordId actorId, movieId;
+        while (getline(file, line)) {
+            parsedRows += parseCastLine(line, actorId, movieId);
+        }
+    });
+
+    long long perRowFound = 0;
+    double perRowTime = timeMilliseconds([&]() {
+        ifstream file(fileName);
+        string line;
+        getline(file, line);
+        RecordId actorId, movieId;
+        while (getline(file, line)) {
+            if (!parseCastLine(line, actorId, movieId))
+                continue;
+            Actor* actor = actorDictionary.get(actorId);
+            Movie* movie = movieDictionary.get(movieId);
+            perRowFound += actor && movie;
+        }
+    });
+
+    long long batchedFound = 0;
+    double batchedTime = timeMilliseconds([&]() {
+        ifstream file(fileName);
+        vector<RecordId> castActorIds, castMovieIds;
+        string line;
+        getline(file, line);
+        RecordId actorId, movieId;
+        while (getline(file, line)) {
+            if (!parseCastLine(line, actorId, movieId))
+                continue;
+            castActorIds.push_back(actorId);
+            castMovieIds.push_back(movieId);
+        }
+        vector<Actor*> castActors;
+        vector<Movie*> castMovies;
+        actorDictionary.getMany(castActorIds, castActors);
+        movieDictionary.getMany(castMovieIds, castMovies);
+        for (size_t i = 0; i < castActors.size(); i++) {
+            batchedFound += castActors[i] && castMovies[i];
+        }
+    });
+    filesystem::remove(fileName);
+
+    printTiming("parse only", parseTime, parsedRows);
+    printTiming("one get per row", perRowTime, parsedRows);
+    printTiming("parse, then getMany", batchedTime, parsedRows);
+    if (perRowFound != batchedFound) {
+        cout << "[Error] The loaders disagree: " << perRowFound << " rows found one get at a time, "
+             << batchedFound << " with getMany\n";
+    }
+}
+
+// ==================== Verification ====================
+
+/*
+    Prints the statistics and slot order of a table
+
+    Two tables that were given the same operations print the same lines exactly when every entry
+    ended up in the same slot, which is what the SSE2 and scalar scans must agree on.
+*/
+template <typename KeyType>
+void printFingerprint(const string& label, const HashTable<KeyType, int>& table) {
+    HashTableStats stats = table.getStats();
+    cout << label << ": size " << stats.size << ", capacity " << stats.capacity
+         << ", tombstones " << stats.tombstones << ", max probe " << stats.maxProbeLength
+         << ", average probe " << fixed << setprecision(6) << stats.averageProbeLength << "\n";
+    cout << label << ": group occupancy";
+    for (int groups : stats.groupOccupancy) {
+        cout << " " << groups;
+    }
+    cout << "\n";
+
+    // Order-sensitive checksum of the entries as they lie in the slot arrays
+    unsigned long long checksum = 0;
+    for (const auto& entry : table) {
+        checksum = checksum * 1000003ULL + static_cast<unsigned long long>(hashKey(entry.key)) + static_cast<unsigned long long>(entry.value);
+    }
+    cout << label << ": slot order checksum " << checksum << "\n";
+}
+
+/*
+    Runs a fixed sequence of inserts, erases and finds on a HashTable and a std::unordered_map
+
+    Parameter - label: The name printed with the fingerprint
+    Parameter - makeKey: A callable turning an integer into a key
+    Return - The number of operations whose result differed from std::unordered_map
+*/
+template <typename KeyType, typename MakeKey>
+int verifyTable(const string& label, MakeKey makeKey) {
+    HashTable<KeyType, int> table;
+    unordered_map<KeyType, int> expected;
+    mt19937 random(42);
+    int mismatches = 0;
+
+    for (int i = 0; i < 200000; i++) {
+        int value = static_cast<int>(random() % 50000);
+        KeyType key = makeKey(value);
+        switch (random() % 4) {
+        case 0:
+        case 1:
+            mismatches += table.insert(key, value) != expected.emplace(key, value).second;
+            break;
+        case 2:
+            mismatches += table.erase(key) != (expected.erase(key) == 1);
+            break;
+        default: {
+            const int* found = table.find(key);
+            typename unordered_map<KeyType, int>::const_iterator it = expected.find(key);
+            mismatches += (found != nullptr) != (it != expected.end()) || (found && *found != it->second);
+        }
+        }
+    }
+
+    mismatches += table.size() != static_cast<int>(expected.size());
+    for (const auto& entry : expected) {
+        const int* found = table.find(entry.first);
+        mismatches += !found || *found != entry.second;
+    }
+
+    printFingerprint(label, table);
+    return mismatches;
+}
+
+int runVerify() {
+    int mismatches = 0;
+    mismatches += verifyTable<RecordId>("RecordId keys", [](int value) { return static_cast<RecordId>(value * 7919u); });
+    mismatches += verifyTable<string>("string keys", [](int value) { return "key-" + to_string(value); });
+    if (mismatches > 0) {
+        cerr << "[Error] " << mismatches << " results differed from std::unordered_map\n";
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    bool quick = false;
+    vector<string> sections;
+    for (int i = 1; i < argc; i++) {
+        string argument = argv[i];
+        if (argument == "--verify")
+            return runVerify();
+        if (argument == "--quick")
+            quick = true;
+        else
+            sections.push_back(argument);
+    }
+
+    auto selected = [&](const string& name) {
+        return sections.empty() || find(sections.begin(), sections.end(), name) != sections.end();
+    };
+
+    if (selected("lookup"))
+        benchmarkLookup(quick ? vector<int>{ 20000 } : vector<int>{ 20000, 1000000 });
+    if (selected("scaling"))
+        benchmarkScaling(quick ? 20000 : 200000, quick ? 200000 : 2000000);
+    if (selected("cast"))
+        benchmarkCast(quick ? 20000 : 1000000, quick ? 100000 : 4000000);
+    return 0;
+}
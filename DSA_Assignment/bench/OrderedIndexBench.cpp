@@ -0,0 +1,148 @@
+/*
+    OrderedIndexBench - BTree against AVLTree as the ordered index of a Dictionary
+
+    Usage: OrderedIndexBench [--quick]
+
+    Both trees hold KeyValuePair<RecordId, Actor>, the entries of a Dictionary's ordered index.
+    For every size the same random keys are inserted, looked up (hits, in a different random order),
+    scanned in order from begin() to end(), and removed. The program checks that both trees found every key
+    and scanned every entry in ascending order, and exits with 1 if not.
+
+    --quick   Uses 10,000 entries only, for a fast smoke run (the default sizes are 10k, 1M and 10M)
+*/
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+
+#include "BTree.h"
+#include "AVLTree.h"
+#include "Dictionary.h"
+#include "Actor.h"
+
+using namespace std;
+
+namespace {
+
+typedef KeyValuePair<RecordId, Actor> Entry;
+
+// Time of each operation over the whole key set, in milliseconds
+struct TreeTimings {
+    double insert;
+    double find;
+    double scan;
+    double remove;
+    bool correct;       // Every key was found, and the scan saw every entry in ascending order
+
+    TreeTimings() : insert(0), find(0), scan(0), remove(0), correct(true) {}
+};
+
+/*
+    Times a piece of work
+
+    Parameter - work: A callable run once
+    Return - The elapsed time in milliseconds
+*/
+template <typename Work>
+double timeMilliseconds(Work work) {
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    work();
+    chrono::steady_clock::time_point end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+/*
+    Inserts, finds, scans and removes a set of keys in one tree
+
+    Parameter - keys: The distinct keys, in insertion order
+    Parameter - lookups: The same keys in the order they are looked up and removed
+    Return - The timings of each operation
+*/
+template <typename Tree>
+TreeTimings runTree(const vector<RecordId>& keys, const vector<RecordId>& lookups) {
+    TreeTimings timings;
+    Tree tree;
+
+    timings.insert = timeMilliseconds([&]() {
+        for (RecordId key : keys) {
+            tree.emplace(key, nullptr);
+        }
+    });
+
+    size_t found = 0;
+    timings.find = timeMilliseconds([&]() {
+        for (RecordId key : lookups) {
+            found += tree.find(key) != nullptr;
+        }
+    });
+
+    size_t scanned = 0;
+    bool ascending = true;
+    timings.scan = timeMilliseconds([&]() {
+        RecordId previous = 0;
+        for (const Entry& entry : tree) {
+            ascending &= scanned == 0 || previous < entry.key;
+            previous = entry.key;
+            scanned++;
+        }
+    });
+
+    size_t removed = 0;
+    timings.remove = timeMilliseconds([&]() {
+        for (RecordId key : lookups) {
+            removed += tree.remove(key);
+        }
+    });
+
+    timings.correct = found == keys.size() && scanned == keys.size() && ascending
+        && removed == keys.size() && tree.size() == 0;
+    return timings;
+}
+
+// Prints one row of the table: milliseconds and nanoseconds per entry for the operation in both trees
+void printRow(const string& operation, double btree, double avl, size_t count) {
+    cout << "  " << left << setw(8) << operation << right << fixed << setprecision(1)
+         << setw(10) << btree << " ms" << setw(8) << btree * 1e6 / count << " ns"
+         << setw(10) << avl << " ms" << setw(8) << avl * 1e6 / count << " ns"
+         << setw(8) << setprecision(2) << avl / btree << "x\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    bool quick = argc > 1 && string(argv[1]) == "--quick";
+    vector<int> sizes = quick ? vector<int>{ 10000 } : vector<int>{ 10000, 1000000, 10000000 };
+
+    cout << "BTree (" << BTREE_NODE_BYTES << "-byte nodes) against AVLTree, KeyValuePair<RecordId, Actor>\n";
+    bool correct = true;
+    for (int size : sizes) {
+        // Distinct keys spread over most of the 32-bit range, in random order
+        vector<RecordId> keys(size);
+        for (int i = 0; i < size; i++) {
+            keys[i] = static_cast<RecordId>(i) * 397 + 1;
+        }
+        mt19937 random(size);
+        shuffle(keys.begin(), keys.end(), random);
+        vector<RecordId> lookups = keys;
+        shuffle(lookups.begin(), lookups.end(), random);
+
+        TreeTimings btree = runTree<BTree<Entry>>(keys, lookups);
+        TreeTimings avl = runTree<AVLTree<Entry>>(keys, lookups);
+
+        cout << "\n" << size << " entries\n";
+        cout << "  " << setw(8) << "" << setw(24) << "BTree" << setw(24) << "AVLTree" << setw(11) << "AVL/BTree" << "\n";
+        printRow("insert", btree.insert, avl.insert, keys.size());
+        printRow("find", btree.find, avl.find, keys.size());
+        printRow("scan", btree.scan, avl.scan, keys.size());
+        printRow("remove", btree.remove, avl.remove, keys.size());
+
+        if (!btree.correct || !avl.correct) {
+            cout << "[Error] " << (btree.correct ? "AVLTree" : "BTree") << " lost or misordered entries\n";
+            correct = false;
+        }
+    }
+    return correct ? 0 : 1;
+}
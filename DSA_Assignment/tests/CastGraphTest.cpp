@@ -0,0 +1,182 @@
+/*
+    CastGraphTest - randomized checks of CastGraph against a reference map of actors to movies
+
+    A random sequence of addEdge, addActor, addMovie, removeActor, removeMovie, hasEdge and compact is applied
+    to the graph and to two std::maps (actor -> movies, movie -> actors). Every call's result must match the
+    maps. Every few hundred operations the vertex and edge counts are compared, and getMovies and getActors
+    must list exactly each vertex's neighbours, with no duplicates.
+
+    The IDs are drawn from a small range so the same vertices are added and removed many times. That exercises
+    removeVertex moving the last vertex of a partition into the removed one's place and re-pointing its
+    neighbours, and compact and expand switching between the two edge layouts in the middle of it.
+    It exits with 1 if a check fails.
+*/
+#include <iostream>
+#include <string>
+#include <vector>
+#include <set>
+#include <map>
+#include <random>
+
+#include "CastGraph.h"
+
+using namespace std;
+
+namespace {
+
+const int OPERATIONS = 200000;
+const int ID_RANGE = 300;
+const int CHECK_INTERVAL = 500;
+
+typedef map<RecordId, set<RecordId>> Neighbours;
+
+int failures = 0;
+
+// Reports a failed check, printing only the first few so a broken graph does not flood the output
+void fail(const string& message) {
+    if (failures < 20)
+        cerr << "[Error] " << message << "\n";
+    failures++;
+}
+
+/*
+    Removes a vertex from the reference maps
+
+    Parameter - neighbours: The map of the vertex's partition
+    Parameter - otherNeighbours: The map of the other partition
+    Parameter - id: The ID of the vertex
+    Return - The number of edges removed with the vertex
+*/
+int removeFromReference(Neighbours& neighbours, Neighbours& otherNeighbours, RecordId id) {
+    int edges = 0;
+    for (RecordId other : neighbours[id]) {
+        otherNeighbours[other].erase(id);
+        edges++;
+    }
+    neighbours.erase(id);
+    return edges;
+}
+
+/*
+    Checks that a listing of neighbours holds exactly the expected IDs, once each
+
+    Parameter - what: A description of the listing for the error message
+    Parameter - listed: The IDs returned by the graph
+    Parameter - expected: The IDs in the reference map
+    Return - None (failed checks are counted in failures)
+*/
+void checkListing(const string& what, const vector<RecordId>& listed, const set<RecordId>& expected) {
+    if (listed.size() != expected.size() || set<RecordId>(listed.begin(), listed.end()) != expected)
+        fail(what + " lists " + to_string(listed.size()) + " IDs, expected " + to_string(expected.size()));
+}
+
+/*
+    Compares the whole graph against the reference maps
+
+    Parameter - graph: The graph
+    Parameter - moviesOf: The reference actor -> movies map
+    Parameter - actorsOf: The reference movie -> actors map
+    Parameter - edges: The reference number of edges
+    Return - None (failed checks are counted in failures)
+*/
+void checkGraph(const CastGraph& graph, const Neighbours& moviesOf, const Neighbours& actorsOf, int edges) {
+    if (graph.getActorCount() != static_cast<int>(moviesOf.size()) || graph.getMovieCount() != static_cast<int>(actorsOf.size())
+        || graph.getEdgeCount() != edges) {
+        fail("Counts are " + to_string(graph.getActorCount()) + " actors, " + to_string(graph.getMovieCount())
+            + " movies, " + to_string(graph.getEdgeCount()) + " edges; expected " + to_string(moviesOf.size()) + ", "
+            + to_string(actorsOf.size()) + ", " + to_string(edges));
+    }
+    for (const auto& actor : moviesOf) {
+        if (!graph.hasActor(actor.first))
+            fail("Actor " + to_string(actor.first) + " is missing");
+        checkListing("getMovies(" + to_string(actor.first) + ")", graph.getMovies(actor.first), actor.second);
+    }
+    for (const auto& movie : actorsOf) {
+        if (!graph.hasMovie(movie.first))
+            fail("Movie " + to_string(movie.first) + " is missing");
+        checkListing("getActors(" + to_string(movie.first) + ")", graph.getActors(movie.first), movie.second);
+    }
+}
+
+} // namespace
+
+int main() {
+    CastGraph graph;
+    Neighbours moviesOf, actorsOf;
+    int edges = 0;
+    int compactions = 0;
+    mt19937 random(11);
+
+    for (int i = 0; i < OPERATIONS; i++) {
+        RecordId actorId = random() % ID_RANGE;
+        RecordId movieId = random() % ID_RANGE;
+        int operation = random() % 20;
+
+        if (operation < 10) {
+            bool added = moviesOf[actorId].insert(movieId).second;
+            actorsOf[movieId].insert(actorId);
+            edges += added;
+            if (graph.addEdge(actorId, movieId) != added)
+                fail("addEdge(" + to_string(actorId) + ", " + to_string(movieId) + ") disagrees with the reference");
+        }
+        else if (operation < 11) {
+            bool added = moviesOf.find(actorId) == moviesOf.end();
+            moviesOf[actorId];
+            if (graph.addActor(actorId) != added)
+                fail("addActor(" + to_string(actorId) + ") disagrees with the reference");
+        }
+        else if (operation < 12) {
+            bool added = actorsOf.find(movieId) == actorsOf.end();
+            actorsOf[movieId];
+            if (graph.addMovie(movieId) != added)
+                fail("addMovie(" + to_string(movieId) + ") disagrees with the reference");
+        }
+        else if (operation < 14) {
+            bool present = moviesOf.count(actorId) == 1;
+            if (present)
+                edges -= removeFromReference(moviesOf, actorsOf, actorId);
+            if (graph.removeActor(actorId) != present)
+                fail("removeActor(" + to_string(actorId) + ") disagrees with the reference");
+        }
+        else if (operation < 16) {
+            bool present = actorsOf.count(movieId) == 1;
+            if (present)
+                edges -= removeFromReference(actorsOf, moviesOf, movieId);
+            if (graph.removeMovie(movieId) != present)
+                fail("removeMovie(" + to_string(movieId) + ") disagrees with the reference");
+        }
+        else if (operation < 17) {
+            graph.compact();
+            compactions++;
+            if (!graph.isCompacted())
+                fail("compact() left the graph in adjacency lists");
+        }
+        else {
+            Neighbours::const_iterator actor = moviesOf.find(actorId);
+            bool expected = actor != moviesOf.end() && actor->second.count(movieId) == 1;
+            if (graph.hasEdge(actorId, movieId) != expected)
+                fail("hasEdge(" + to_string(actorId) + ", " + to_string(movieId) + ") disagrees with the reference");
+        }
+
+        if (i % CHECK_INTERVAL == 0)
+            checkGraph(graph, moviesOf, actorsOf, edges);
+    }
+
+    // Check both layouts of the final graph
+    graph.compact();
+    checkGraph(graph, moviesOf, actorsOf, edges);
+    graph.addActor(ID_RANGE);
+    moviesOf[ID_RANGE];
+    if (graph.isCompacted())
+        fail("Adding an actor did not expand the compacted graph");
+    checkGraph(graph, moviesOf, actorsOf, edges);
+
+    cout << "[Info] " << OPERATIONS << " operations (" << compactions << " compactions), " << graph.getActorCount()
+         << " actors, " << graph.getMovieCount() << " movies and " << graph.getEdgeCount() << " edges left\n";
+    if (failures > 0) {
+        cerr << "[Error] " << failures << " checks failed\n";
+        return 1;
+    }
+    cout << "[Success] CastGraph matched the reference maps\n";
+    return 0;
+}
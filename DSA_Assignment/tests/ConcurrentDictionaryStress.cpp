@@ -0,0 +1,171 @@
+/*
+    ConcurrentDictionaryStress - hammers ConcurrentDictionary from several threads at once
+
+    Reader threads call get on random keys while writer threads call add, emplace and remove on the same
+    (overlapping) keys. Every record a reader sees must belong to the key it asked for. When all threads
+    have stopped, getSize must equal the number of successful inserts minus successful removes, and every
+    key that is still present must resolve to a record for that key.
+
+    The test is meant to be built with ThreadSanitizer (see tests/CMakeLists.txt), which reports any
+    data race the locking misses. It exits with 1 if a check fails.
+*/
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <random>
+
+#include "ConcurrentDictionary.h"
+#include "RecordId.h"
+
+using namespace std;
+
+namespace {
+
+// Number of distinct keys the threads fight over
+const int KEY_COUNT = 512;
+
+const int READER_THREADS = 4;
+const int WRITER_THREADS = 4;
+const int OPERATIONS_PER_WRITER = 20000;
+
+// Record stored in the dictionary: its own key, and who created it
+struct Record {
+    RecordId id;
+    string owner;
+
+    Record(RecordId id, string owner) : id(id), owner(owner) {}
+};
+
+// Stream buffer that discards everything written to it
+class NullBuffer : public streambuf {
+protected:
+    int overflow(int c) override { return traits_type::not_eof(c); }
+    streamsize xsputn(const char*, streamsize count) override { return count; }
+};
+
+/*
+    Checks a record returned for a key
+
+    Parameter - key: The key that was looked up
+    Parameter - record: The record returned (may be nullptr)
+    Return - True if the record is absent or belongs to the key
+*/
+bool recordMatches(RecordId key, const Record* record) {
+    return !record || (record->id == key && !record->owner.empty());
+}
+
+} // namespace
+
+int main() {
+    ConcurrentDictionary<RecordId, Record> dictionary;
+
+    // Records for add() are owned by the test; each key has one, created before any thread starts
+    vector<Record> sharedRecords;
+    sharedRecords.reserve(KEY_COUNT);
+    for (int key = 0; key < KEY_COUNT; key++) {
+        sharedRecords.emplace_back(static_cast<RecordId>(key), "add");
+    }
+
+    // Overlapping adds are expected to fail, so silence the dictionary's duplicate key messages
+    // (the buffer is swapped before any thread starts and restored after they have all stopped)
+    NullBuffer discard;
+    streambuf* errorBuffer = cerr.rdbuf(&discard);
+
+    atomic<bool> writersDone(false);
+    atomic<long long> inserted(0), removed(0), readerErrors(0), reads(0);
+
+    vector<thread> threads;
+    for (int w = 0; w < WRITER_THREADS; w++) {
+        threads.emplace_back([&, w]() {
+            mt19937 random(100 + w);
+            long long localInserted = 0, localRemoved = 0;
+            for (int i = 0; i < OPERATIONS_PER_WRITER; i++) {
+                RecordId key = static_cast<RecordId>(random() % KEY_COUNT);
+                switch (random() % 3) {
+                case 0:
+                    localInserted += dictionary.add(key, &sharedRecords[key]);
+                    break;
+                case 1:
+                    localInserted += dictionary.emplace(key, key, "emplace " + to_string(w)) != nullptr;
+                    break;
+                default:
+                    localRemoved += dictionary.remove(key);
+                    break;
+                }
+            }
+            inserted += localInserted;
+            removed += localRemoved;
+        });
+    }
+
+    for (int r = 0; r < READER_THREADS; r++) {
+        threads.emplace_back([&, r]() {
+            mt19937 random(200 + r);
+            long long localReads = 0, localErrors = 0;
+            while (!writersDone.load()) {
+                RecordId key = static_cast<RecordId>(random() % KEY_COUNT);
+                localErrors += !recordMatches(key, dictionary.get(key));
+                localReads++;
+            }
+            reads += localReads;
+            readerErrors += localErrors;
+        });
+    }
+
+    for (int w = 0; w < WRITER_THREADS; w++) {
+        threads[w].join();
+    }
+    writersDone = true;
+    for (size_t t = WRITER_THREADS; t < threads.size(); t++) {
+        threads[t].join();
+    }
+    cerr.rdbuf(errorBuffer);
+
+    // Check the final state from a single thread
+    int failures = 0;
+    long long expectedSize = inserted.load() - removed.load();
+    if (dictionary.getSize() != expectedSize) {
+        cerr << "[Error] getSize() is " << dictionary.getSize() << ", expected " << expectedSize
+             << " (" << inserted.load() << " inserts, " << removed.load() << " removes)\n";
+        failures++;
+    }
+
+    int present = 0;
+    for (int key = 0; key < KEY_COUNT; key++) {
+        Record* record = dictionary.get(static_cast<RecordId>(key));
+        if (!record)
+            continue;
+        present++;
+        bool fromAdd = record == &sharedRecords[key];
+        bool fromEmplace = record->owner.compare(0, 8, "emplace ") == 0;
+        if (record->id != static_cast<RecordId>(key) || (!fromAdd && !fromEmplace)) {
+            cerr << "[Error] Key " << key << " resolves to a record for key " << record->id << "\n";
+            failures++;
+        }
+    }
+    if (present != dictionary.getSize()) {
+        cerr << "[Error] " << present << " keys resolve, but getSize() is " << dictionary.getSize() << "\n";
+        failures++;
+    }
+
+    int visited = 0;
+    dictionary.forEach([&visited](Record*) { visited++; });
+    if (visited != present) {
+        cerr << "[Error] forEach visited " << visited << " records, " << present << " keys resolve\n";
+        failures++;
+    }
+
+    if (readerErrors.load() > 0) {
+        cerr << "[Error] Readers saw " << readerErrors.load() << " records for the wrong key\n";
+        failures++;
+    }
+
+    cout << "[Info] " << inserted.load() << " inserts, " << removed.load() << " removes, "
+         << reads.load() << " reads, " << present << " keys left\n";
+    if (failures > 0)
+        return 1;
+    cout << "[Success] ConcurrentDictionary stayed consistent\n";
+    return 0;
+}
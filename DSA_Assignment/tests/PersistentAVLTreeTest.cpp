@@ -0,0 +1,198 @@
+/*
+    PersistentAVLTreeTest - randomized checks of PersistentAVLTree against std::set, and snapshot reads under a writer
+
+    The first part applies a random sequence of insert, remove and find to the tree and to a std::set, and keeps
+    a snapshot (with a copy of the set) every few thousand operations. At the end every kept snapshot must still
+    hold exactly the elements the set had when it was taken, although the tree has changed and been cleared
+    since. visitFrom and visitDescending are checked against the set as well.
+
+    The second part runs one writer thread inserting and removing while several reader threads take
+    snapshots and scan them. Every scan must be in ascending order and match the snapshot's size, and
+    scanning the same snapshot again later must give the same elements. The test is built with
+    ThreadSanitizer (see tests/CMakeLists.txt), which reports any unsynchronized access to the root.
+    It exits with 1 if a check fails.
+*/
+#include <iostream>
+#include <string>
+#include <vector>
+#include <set>
+#include <thread>
+#include <atomic>
+#include <random>
+#include <utility>
+
+#include "PersistentAVLTree.h"
+
+using namespace std;
+
+namespace {
+
+const int RANDOM_OPERATIONS = 200000;
+const int RANDOM_KEY_RANGE = 3000;
+const int SNAPSHOT_INTERVAL = 20000;
+
+const int READER_THREADS = 3;
+const int WRITER_OPERATIONS = 100000;
+const int CONCURRENT_KEY_RANGE = 5000;
+
+int failures = 0;
+
+// Reports a failed check
+void fail(const string& message) {
+    cerr << "[Error] " << message << "\n";
+    failures++;
+}
+
+/*
+    Builds a key long enough that the string is stored on the heap, so copies made by path-copying are real copies
+
+    Parameter - number: The number the key is made from
+    Return - The key
+*/
+string makeKey(unsigned number) {
+    return to_string(number) + "-long-enough-to-be-on-the-heap";
+}
+
+/*
+    Applies random operations to the tree and to a std::set, and checks the results and the kept snapshots
+
+    Return - None (failed checks are counted in failures)
+*/
+void testAgainstSet() {
+    PersistentAVLTree<string> tree;
+    set<string> expected;
+    vector<pair<PersistentAVLTree<string>::Snapshot, vector<string>>> kept;
+    mt19937 random(3);
+
+    for (int i = 0; i < RANDOM_OPERATIONS; i++) {
+        string key = makeKey(random() % RANDOM_KEY_RANGE);
+        int operation = random() % 5;
+        if (operation < 2) {
+            if (tree.insert(key) != expected.insert(key).second)
+                fail("insert(" + key + ") disagrees with std::set");
+        }
+        else if (operation < 4) {
+            if (tree.remove(key) != (expected.erase(key) == 1))
+                fail("remove(" + key + ") disagrees with std::set");
+        }
+        else if ((tree.snapshot().find(key) != nullptr) != (expected.count(key) == 1)) {
+            fail("find(" + key + ") disagrees with std::set");
+        }
+
+        if (i % SNAPSHOT_INTERVAL == 0)
+            kept.emplace_back(tree.snapshot(), vector<string>(expected.begin(), expected.end()));
+    }
+
+    vector<string> items(expected.begin(), expected.end());
+    PersistentAVLTree<string>::Snapshot last = tree.snapshot();
+    if (tree.size() != static_cast<int>(expected.size()) || last.getAllItems() != items)
+        fail("The final tree does not hold the elements of std::set");
+
+    vector<string> descending;
+    last.visitDescending([&descending](const string& item) { descending.push_back(item); return true; });
+    if (descending != vector<string>(items.rbegin(), items.rend()))
+        fail("visitDescending does not visit the elements in descending order");
+
+    vector<string> fromFive;
+    last.visitFrom(string("5"), [&fromFive](const string& item) { fromFive.push_back(item); return true; });
+    if (fromFive != vector<string>(expected.lower_bound("5"), expected.end()))
+        fail("visitFrom(\"5\") does not start at the lower bound");
+
+    // Old versions must be untouched by everything done after them, including clear
+    tree.clear();
+    if (tree.size() != 0)
+        fail("clear() left elements in the tree");
+    for (size_t k = 0; k < kept.size(); k++) {
+        if (kept[k].first.size() != static_cast<int>(kept[k].second.size()) || kept[k].first.getAllItems() != kept[k].second)
+            fail("Snapshot " + to_string(k) + " changed after it was taken");
+    }
+    if (last.getAllItems() != items)
+        fail("The last snapshot changed after clear()");
+}
+
+/*
+    Scans a snapshot in ascending order
+
+    Parameter - snapshot: The snapshot to scan
+    Parameter - items: Receives the elements
+    Return - True if the elements were ascending and as many as the snapshot's size
+*/
+bool scanSnapshot(const PersistentAVLTree<int>::Snapshot& snapshot, vector<int>& items) {
+    items.clear();
+    bool ascending = true;
+    snapshot.visitFrom(0, [&](int item) {
+        ascending &= items.empty() || items.back() < item;
+        items.push_back(item);
+        return true;
+    });
+    return ascending && static_cast<int>(items.size()) == snapshot.size();
+}
+
+/*
+    Runs one writer and several readers on the same tree
+
+    Return - None (failed checks are counted in failures)
+*/
+void testWriterWithReaders() {
+    PersistentAVLTree<int> tree;
+    atomic<bool> writerDone(false);
+    atomic<long long> badScans(0), changedSnapshots(0), scans(0);
+
+    thread writer([&]() {
+        mt19937 random(9);
+        for (int i = 0; i < WRITER_OPERATIONS; i++) {
+            int key = random() % CONCURRENT_KEY_RANGE;
+            if (random() % 2)
+                tree.insert(key);
+            else
+                tree.remove(key);
+        }
+        writerDone = true;
+    });
+
+    vector<thread> readers;
+    for (int r = 0; r < READER_THREADS; r++) {
+        readers.emplace_back([&]() {
+            vector<int> first, second;
+            long long localScans = 0, localBad = 0, localChanged = 0;
+            while (!writerDone.load()) {
+                PersistentAVLTree<int>::Snapshot snapshot = tree.snapshot();
+                localBad += !scanSnapshot(snapshot, first);
+                this_thread::yield();   // Let the writer publish more versions before the second scan
+                localBad += !scanSnapshot(snapshot, second);
+                localChanged += first != second;
+                localScans += 2;
+            }
+            scans += localScans;
+            badScans += localBad;
+            changedSnapshots += localChanged;
+        });
+    }
+
+    writer.join();
+    for (thread& reader : readers) {
+        reader.join();
+    }
+
+    if (badScans.load() > 0)
+        fail(to_string(badScans.load()) + " scans were out of order or did not match the snapshot's size");
+    if (changedSnapshots.load() > 0)
+        fail(to_string(changedSnapshots.load()) + " snapshots changed while they were held");
+
+    vector<int> items;
+    if (!scanSnapshot(tree.snapshot(), items))
+        fail("The final version is out of order");
+    cout << "[Info] " << scans.load() << " snapshot scans during " << WRITER_OPERATIONS << " writes, "
+         << items.size() << " elements left\n";
+}
+
+} // namespace
+
+int main() {
+    testAgainstSet();
+    testWriterWithReaders();
+    if (failures > 0)
+        return 1;
+    cout << "[Success] PersistentAVLTree matched std::set and every snapshot stayed unchanged\n";
+    return 0;
+}